@@ -196,6 +196,191 @@ static FAR struct can_reader_s *init_can_reader(FAR struct file *filep)
   return reader;
 }
 
+#ifdef CONFIG_CAN_READER_FILTER
+/****************************************************************************
+ * Name: can_rdfilter_key
+ *
+ * Description:
+ *   Return the message ID with the extended ID flag folded in.
+ *
+ ****************************************************************************/
+
+static inline uint32_t can_rdfilter_key(uint32_t id, bool extid)
+{
+  return extid ? id | CAN_RDFILTER_EXTFLAG : id;
+}
+
+/****************************************************************************
+ * Name: can_rdfilter_hash
+ ****************************************************************************/
+
+static inline unsigned int can_rdfilter_hash(uint32_t key)
+{
+  key ^= key >> 16;
+  key ^= key >> 8;
+  key ^= key >> 4;
+  return key & (CAN_RDFILTER_NHASH - 1);
+}
+
+/****************************************************************************
+ * Name: can_reader_match
+ *
+ * Description:
+ *   Check whether a received frame passes the reader's filter list.  The
+ *   exact ID filters are looked up in the hash table first, then the
+ *   masked filters are scanned.
+ *
+ * Assumptions:
+ *   Called from can_receive() with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static bool can_reader_match(FAR struct can_reader_s *reader,
+                             FAR const struct can_hdr_s *hdr)
+{
+  FAR const struct can_rdmatch_s *match;
+  uint32_t key;
+  int i;
+
+  if (reader->rd_nfilters == 0)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_CAN_ERRORS
+  if (hdr->ch_error)
+    {
+      return true;
+    }
+#endif
+
+#ifdef CONFIG_CAN_EXTID
+  key = can_rdfilter_key(hdr->ch_id, hdr->ch_extid);
+#else
+  key = can_rdfilter_key(hdr->ch_id, false);
+#endif
+
+  for (i = reader->rd_hash[can_rdfilter_hash(key)]; i != 0;
+       i = match->rm_next)
+    {
+      match = &reader->rd_filters[i - 1];
+      if (match->rm_id == key)
+        {
+          return true;
+        }
+    }
+
+  for (i = reader->rd_nexact; i < reader->rd_nfilters; i++)
+    {
+      match = &reader->rd_filters[i];
+      if (((key ^ match->rm_id) & match->rm_mask) == 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: can_reader_setfilter
+ *
+ * Description:
+ *   Compile the user's filter list into the reader: exact ID filters are
+ *   chained into the hash buckets, masked filters follow them.
+ *
+ * Assumptions:
+ *   Called from can_ioctl() with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static int can_reader_setfilter(FAR struct can_reader_s *reader,
+                                FAR const struct canioc_rdfilter_s *rdf)
+{
+  FAR const struct can_rdfilter_s *filter;
+  FAR struct can_rdmatch_s *match;
+  uint32_t maxid;
+  bool extid;
+  int nmask;
+  int pass;
+  int i;
+
+  if (reader == NULL || rdf == NULL ||
+      rdf->rf_nfilters > CONFIG_CAN_READER_NFILTERS ||
+      (rdf->rf_nfilters > 0 && rdf->rf_filters == NULL))
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < rdf->rf_nfilters; i++)
+    {
+      filter = &rdf->rf_filters[i];
+#ifdef CONFIG_CAN_EXTID
+      maxid  = filter->rf_extid ? CAN_MAX_EXTMSGID : CAN_MAX_STDMSGID;
+#else
+      maxid  = CAN_MAX_STDMSGID;
+#endif
+      if (filter->rf_id > maxid)
+        {
+          return -EINVAL;
+        }
+    }
+
+  reader->rd_nfilters = 0;
+  reader->rd_nexact   = 0;
+  memset(reader->rd_hash, 0, sizeof(reader->rd_hash));
+
+  /* The first pass collects the exact ID filters, the second one the
+   * masked filters.
+   */
+
+  for (nmask = 0, pass = 0; pass < 2; pass++)
+    {
+      for (i = 0; i < rdf->rf_nfilters; i++)
+        {
+          filter = &rdf->rf_filters[i];
+#ifdef CONFIG_CAN_EXTID
+          extid  = filter->rf_extid;
+#else
+          extid  = false;
+#endif
+          maxid  = extid ? CAN_MAX_EXTMSGID : CAN_MAX_STDMSGID;
+
+          if ((filter->rf_mask & maxid) == maxid)
+            {
+              unsigned int hash;
+
+              if (pass != 0)
+                {
+                  continue;
+                }
+
+              match          = &reader->rd_filters[reader->rd_nexact++];
+              match->rm_id   = can_rdfilter_key(filter->rf_id, extid);
+              match->rm_mask = UINT32_MAX;
+
+              hash                 = can_rdfilter_hash(match->rm_id);
+              match->rm_next       = reader->rd_hash[hash];
+              reader->rd_hash[hash] = reader->rd_nexact;
+            }
+          else if (pass != 0)
+            {
+              match          = &reader->rd_filters[reader->rd_nexact +
+                                                   nmask++];
+              match->rm_id   = can_rdfilter_key(filter->rf_id &
+                                                filter->rf_mask, extid);
+              match->rm_mask = (filter->rf_mask & maxid) |
+                               CAN_RDFILTER_EXTFLAG;
+              match->rm_next = 0;
+            }
+        }
+    }
+
+  reader->rd_nfilters = reader->rd_nexact + nmask;
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: can_open
  *
@@ -882,6 +1067,20 @@ static int can_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+#ifdef CONFIG_CAN_READER_FILTER
+      /* CANIOC_SET_READER_FILTER: Replace the acceptance filter list of
+       * this reader.  Argument is a reference to struct canioc_rdfilter_s.
+       */
+
+      case CANIOC_SET_READER_FILTER:
+        {
+          ret = can_reader_setfilter(reader,
+                      (FAR const struct canioc_rdfilter_s *)
+                      ((uintptr_t)arg));
+        }
+        break;
+#endif
+
       /* Set specfic can transceiver state */
 
       case CANIOC_SET_TRANSVSTATE:
@@ -1007,6 +1206,9 @@ static int can_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
               dev->cd_fds[i] = fds;
               fds->priv       = &dev->cd_fds[i];
+#ifdef CONFIG_CAN_READER_FILTER
+              dev->cd_fdreaders[i] = reader;
+#endif
               break;
             }
         }
@@ -1146,6 +1348,10 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
   int                      ret = -ENOMEM;
   int                      i;
   int                      sval;
+#ifdef CONFIG_CAN_READER_FILTER
+  bool                     filtered = false;
+  bool                     overflow = false;
+#endif
 
   caninfo("ID: %" PRId32 " DLC: %d\n", (uint32_t)hdr->ch_id, hdr->ch_dlc);
 
@@ -1211,6 +1417,16 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
       FAR struct can_reader_s *reader = (FAR struct can_reader_s *)node;
       fifo = &reader->fifo;
 
+#ifdef CONFIG_CAN_READER_FILTER
+      /* Don't copy the frame or wake up readers that filtered it out */
+
+      if (!can_reader_match(reader, hdr))
+        {
+          filtered = true;
+          continue;
+        }
+#endif
+
       nexttail = fifo->rx_tail + 1;
       if (nexttail >= CONFIG_CAN_RXFIFOSIZE)
         {
@@ -1246,6 +1462,18 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
           fifo->rx_tail = nexttail;
 
+#ifdef CONFIG_CAN_READER_FILTER
+          /* Notify only the poll/select waiters of this reader */
+
+          for (i = 0; i < CONFIG_CAN_NPOLLWAITERS; i++)
+            {
+              if (dev->cd_fdreaders[i] == reader)
+                {
+                  poll_notify(&dev->cd_fds[i], 1, POLLIN);
+                }
+            }
+#endif
+
           if (nxsem_get_value(&fifo->rx_sem, &sval) < 0)
             {
 #ifdef CONFIG_CAN_ERRORS
@@ -1268,16 +1496,31 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 
           ret = OK;
         }
-#ifdef CONFIG_CAN_ERRORS
+#if defined(CONFIG_CAN_ERRORS) || defined(CONFIG_CAN_READER_FILTER)
       else
         {
+#  ifdef CONFIG_CAN_READER_FILTER
+          overflow = true;
+#  endif
+#  ifdef CONFIG_CAN_ERRORS
           /* Report rx overflow error */
 
           fifo->rx_error |= CAN_ERROR5_RXOVERFLOW;
+#  endif
         }
 #endif
     }
 
+#ifdef CONFIG_CAN_READER_FILTER
+  /* A frame that no reader wanted is not an allocation failure.  Only a
+   * full FIFO is reported to the lower half.
+   */
+
+  if (ret < 0 && filtered && !overflow)
+    {
+      ret = OK;
+    }
+#else
   /* Notify all poll/select waiters that they can read from the
    * cd_recv buffer
    */
@@ -1286,6 +1529,7 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
     {
       poll_notify(dev->cd_fds, CONFIG_CAN_NPOLLWAITERS, POLLIN);
     }
+#endif
 
   leave_critical_section(flags);
   return ret;
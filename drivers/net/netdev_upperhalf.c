@@ -29,14 +29,17 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/param.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/can.h>
+#include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev_lowerhalf.h>
 #include <nuttx/net/pkt.h>
+#include <nuttx/net/tcp.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 
@@ -60,6 +63,16 @@
 #  define NETDEV_THREAD_COUNT 1
 #endif
 
+/* Queue N of a multi-queue device is drained on CPU (N % SMP_NCPUS) */
+
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+#  define NETDEV_NQUEUES(l) MAX((l)->nqueues, 1)
+#else
+#  define NETDEV_NQUEUES(l) 1
+#endif
+
+#define NETDEV_RSS_NOCPU 0xff /* Flow not steered in software */
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -80,12 +93,39 @@ struct netdev_upperhalf_s
   struct work_s work;
 #endif
 
-  /* TX queue for re-queueing replies */
+  /* TX queue for re-queueing replies (and GSO segments) */
 
 #if CONFIG_IOB_NCHAINS > 0
   struct iob_queue_s txq;
 #endif
+
+  /* Software flow steering: the CPU each flow hash was last received on,
+   * and the packets handed over to the worker of each CPU.  Protected by
+   * the network lock.
+   */
+
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+  bool               swsteer;
+  uint8_t            flowcpu[CONFIG_NETDEV_RSS_FLOWS];
+  struct iob_queue_s backlog[NETDEV_THREAD_COUNT];
+#endif
+};
+
+/* This structure describes the TCP segment being coalesced by GRO during
+ * one receive poll.
+ */
+
+#ifdef CONFIG_NETDEV_GRO
+struct netdev_upper_gro_s
+{
+  FAR netpkt_t *pkt;           /* Coalesced packet, NULL if none */
+  uint16_t      hdrlen;        /* Length of its IP and TCP headers */
+  uint16_t      nsegs;         /* Number of segments coalesced */
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  uint16_t      sum;           /* Checksum over its TCP payload */
+#endif
 };
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -246,6 +286,231 @@ static inline bool netdev_upper_can_tx(FAR struct netdev_upperhalf_s *upper)
   return quota > 0;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_transmit
+ *
+ * Description:
+ *   Hand a packet to the lower half, on the TX queue of the current CPU
+ *   for multi-queue devices.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline int netdev_upper_transmit(FAR struct netdev_lowerhalf_s *lower,
+                                        FAR netpkt_t *pkt)
+{
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  if (lower->nqueues > 1)
+    {
+      return lower->ops->transmitq(lower, this_cpu() % lower->nqueues, pkt);
+    }
+#endif
+
+  return lower->ops->transmit(lower, pkt);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_receive
+ *
+ * Description:
+ *   Fetch a packet from the lower half, from the given RX queue for
+ *   multi-queue devices.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static inline FAR netpkt_t *
+netdev_upper_receive(FAR struct netdev_lowerhalf_s *lower, int queue)
+{
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  if (lower->nqueues > 1)
+    {
+      return lower->ops->receiveq(lower, queue);
+    }
+#endif
+
+  return lower->ops->receive(lower);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gso_segment
+ *
+ * Description:
+ *   Split the TCP super-segment in d_iob into segments of d_gso_size bytes
+ *   of payload.  The first segment replaces the super-segment in d_iob, the
+ *   others are queued on the TX queue and go out on the following polls.
+ *   Segments that cannot be built for lack of IOBs are dropped and left to
+ *   TCP retransmission.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Returned Value:
+ *   OK if at least the first segment is in d_iob, a negated errno value
+ *   otherwise.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GSO
+static int netdev_upper_gso_segment(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper    = dev->d_private;
+  FAR struct iob_s              *gso      = dev->d_iob;
+  FAR struct iob_s              *first    = NULL;
+  FAR struct iob_s              *seg;
+  FAR struct tcp_hdr_s          *tcp;
+  unsigned int                   llhdrlen = NET_LL_HDRLEN(dev);
+  unsigned int                   iphdrlen;
+  unsigned int                   hdrlen;
+  unsigned int                   total;
+  unsigned int                   offset;
+  unsigned int                   seglen;
+#ifdef CONFIG_NET_IPv4
+  uint16_t                       ipid     = 0;
+#endif
+  uint8_t                        flags;
+  bool                           ipv4     = false;
+  int                            ret      = OK;
+
+  /* Locate the TCP header of the super-segment */
+
+#ifdef CONFIG_NET_IPv4
+  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION &&
+      IPv4BUF->proto == IP_PROTO_TCP)
+    {
+      iphdrlen = (IPv4BUF->vhl & IPv4_HLMASK) << 2;
+      ipid     = ((uint16_t)IPv4BUF->ipid[0] << 8) | IPv4BUF->ipid[1];
+      ipv4     = true;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION &&
+      IPv6BUF->proto == IP_PROTO_TCP)
+    {
+      iphdrlen = IPv6_HDRLEN;
+    }
+  else
+#endif
+    {
+      return -EMSGSIZE;
+    }
+
+  tcp    = IPBUF(iphdrlen);
+  hdrlen = iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+  total  = gso->io_pktlen - hdrlen;
+  flags  = tcp->flags;
+
+  for (offset = 0; offset < total; offset += seglen)
+    {
+      seglen = MIN(dev->d_gso_size, total - offset);
+
+      /* Copy the link layer, IP and TCP headers, then the payload slice */
+
+      seg = iob_tryalloc_fit_large(CONFIG_NET_LL_GUARDSIZE + llhdrlen +
+                                   hdrlen + seglen, false);
+      if (seg == NULL)
+        {
+          ret = -ENOMEM;
+          break;
+        }
+
+      iob_reserve(seg, CONFIG_NET_LL_GUARDSIZE);
+      ret = iob_trycopyin(seg, IOB_DATA(gso) - llhdrlen, llhdrlen + hdrlen,
+                          -(int)llhdrlen, false);
+      if (ret >= 0)
+        {
+          ret = iob_clone_partial(gso, seglen, hdrlen + offset,
+                                  seg, hdrlen, false, false);
+        }
+
+      if (ret < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+
+      /* Fix up the headers of the segment.  FIN and PSH belong to the last
+       * segment only.
+       */
+
+      dev->d_iob = seg;
+      tcp        = IPBUF(iphdrlen);
+
+      net_incr32(tcp->seqno, offset);
+      if (offset + seglen < total)
+        {
+          tcp->flags = flags & ~(TCP_FIN | TCP_PSH);
+        }
+
+      tcp->tcpchksum = 0;
+
+#ifdef CONFIG_NET_IPv4
+      if (ipv4)
+        {
+          FAR struct ipv4_hdr_s *ipv4hdr = IPv4BUF;
+
+          ipv4hdr->len[0]   = (hdrlen + seglen) >> 8;
+          ipv4hdr->len[1]   = (hdrlen + seglen) & 0xff;
+          ipv4hdr->ipid[0]  = ipid >> 8;
+          ipv4hdr->ipid[1]  = ipid & 0xff;
+          ipv4hdr->ipchksum = 0;
+          ipv4hdr->ipchksum = ~ipv4_chksum(ipv4hdr);
+          ipid++;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+          tcp->tcpchksum    = ~ipv4_upperlayer_chksum(dev, IP_PROTO_TCP);
+#endif
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if (!ipv4)
+        {
+          FAR struct ipv6_hdr_s *ipv6hdr = IPv6BUF;
+
+          ipv6hdr->len[0]   = (hdrlen + seglen - IPv6_HDRLEN) >> 8;
+          ipv6hdr->len[1]   = (hdrlen + seglen - IPv6_HDRLEN) & 0xff;
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+          tcp->tcpchksum    = ~ipv6_upperlayer_chksum(dev, IP_PROTO_TCP,
+                                                      IPv6_HDRLEN);
+#endif
+        }
+#endif
+
+      if (first == NULL)
+        {
+          first = seg;
+        }
+      else if ((ret = iob_tryadd_queue(seg, &upper->txq)) < 0)
+        {
+          iob_free_chain(seg);
+          break;
+        }
+    }
+
+  dev->d_iob = gso;
+  if (first == NULL)
+    {
+      return ret < 0 ? ret : -ENOMEM;
+    }
+
+  /* Replace the super-segment by its first segment */
+
+  netdev_iob_replace(dev, first);
+  dev->d_len = netpkt_getdatalen(upper->lower, first);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_txpoll
  *
@@ -280,6 +545,23 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
 
   DEBUGASSERT(dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_GSO
+  /* Split super-segments from TCP into MSS-sized frames first */
+
+  if (dev->d_gso_size > 0 &&
+      netpkt_getdatalen(lower, dev->d_iob) > NETDEV_PKTSIZE(dev))
+    {
+      ret = netdev_upper_gso_segment(dev);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to segment packet: %d\n", ret);
+          NETDEV_TXERRORS(dev);
+          netdev_iob_release(dev);
+          return ret;
+        }
+    }
+#endif
+
   NETDEV_TXPACKETS(dev);
 
 #ifdef CONFIG_NET_PKT
@@ -297,7 +579,7 @@ static int netdev_upper_txpoll(FAR struct net_driver_s *dev)
     }
   else
     {
-      ret = lower->ops->transmit(lower, pkt);
+      ret = netdev_upper_transmit(lower, pkt);
     }
 
   if (ret != OK)
@@ -456,130 +738,842 @@ static void eth_input(FAR struct net_driver_s *dev)
       eth_hdr = (FAR struct eth_hdr_s *)NETLLBUF;
     }
 
-  /* We only accept IP packets of the configured type and ARP packets */
-
+  /* We only accept IP packets of the configured type and ARP packets */
+
+#ifdef CONFIG_NET_IPv4
+  if (eth_hdr->type == HTONS(ETHTYPE_IP))
+    {
+      ninfo("IPv4 frame\n");
+      NETDEV_RXIPV4(dev);
+
+      /* Receive an IPv4 packet from the network device */
+
+      ipv4_input(dev);
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (eth_hdr->type == HTONS(ETHTYPE_IP6))
+    {
+      ninfo("IPv6 frame\n");
+      NETDEV_RXIPV6(dev);
+
+      /* Give the IPv6 packet to the network layer */
+
+      ipv6_input(dev);
+    }
+  else
+#endif
+#ifdef CONFIG_NET_ARP
+  if (eth_hdr->type == HTONS(ETHTYPE_ARP))
+    {
+      ninfo("ARP frame\n");
+      NETDEV_RXARP(dev);
+
+      /* Handle ARP packet */
+
+      arp_input(dev);
+    }
+  else
+#endif
+    {
+      ninfo("INFO: Dropped, Unknown type: %04x\n", eth_hdr->type);
+      NETDEV_RXDROPPED(dev);
+      dev->d_len = 0;
+    }
+
+  /* If the above function invocation resulted in data
+   * that should be sent out on the network,
+   * the field d_len will set to a value > 0.
+   */
+
+  if (dev->d_len > 0)
+    {
+      /* And queue the packet for sending later.
+       * Note: RX is tried before TX, so we don't need to call txavail here.
+       */
+
+      netdev_upper_queue_tx(dev);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: ip_input
+ *
+ * Description:
+ *   Handle L3 packet input.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX network driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_MBIM
+static void ip_input(FAR struct net_driver_s *dev)
+{
+  /* We only accept IP packets of the configured type */
+
+#ifdef CONFIG_NET_IPv4
+  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      ninfo("IPv4 frame\n");
+      NETDEV_RXIPV4(dev);
+
+      /* Receive an IPv4 packet from the network device */
+
+      ipv4_input(dev);
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      ninfo("IPv6 frame\n");
+      NETDEV_RXIPV6(dev);
+
+      /* Give the IPv6 packet to the network layer */
+
+      ipv6_input(dev);
+    }
+  else
+#endif
+    {
+      ninfo("INFO: Dropped, Unknown type\n");
+      NETDEV_RXDROPPED(dev);
+      dev->d_len = 0;
+    }
+
+  /* If the above function invocation resulted in data
+   * that should be sent out on the network,
+   * the field d_len will set to a value > 0.
+   */
+
+  if (dev->d_len > 0)
+    {
+      /* And queue the packet for sending later.
+       * Note: RX is tried before TX, so we don't need to call txavail here.
+       */
+
+      netdev_upper_queue_tx(dev);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_input
+ *
+ * Description:
+ *   Pass a received packet into the network stack.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_input(FAR struct netdev_upperhalf_s *upper,
+                               FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+
+  netpkt_put(dev, pkt, NETPKT_RX);
+
+#ifdef CONFIG_NET_PKT
+  /* When packet sockets are enabled, feed the frame into the tap */
+
+  pkt_input(dev);
+#endif
+
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_LOOPBACK
+    case NET_LL_LOOPBACK:
+#endif
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
+    defined(CONFIG_DRIVERS_IEEE80211)
+      eth_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      ip_input(dev);
+      break;
+#endif
+#ifdef CONFIG_NET_CAN
+    case NET_LL_CAN:
+      ninfo("CAN frame");
+      can_input(dev);
+      break;
+#endif
+    default:
+      nerr("Unknown link type %d\n", dev->d_lltype);
+      break;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_iphdrlen
+ *
+ * Description:
+ *   Return the IP header length of a packet accepted by GRO (which carries
+ *   neither IPv4 options nor IPv6 extension headers).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_GRO
+static inline unsigned int netdev_upper_gro_iphdrlen(FAR const uint8_t *l3)
+{
+#ifdef CONFIG_NET_IPv6
+#  ifdef CONFIG_NET_IPv4
+  if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
+#  endif
+    {
+      return IPv6_HDRLEN;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv4
+  return IPv4_HDRLEN;
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_getseq
+ *
+ * Description:
+ *   Read a TCP sequence number in network order.
+ *
+ ****************************************************************************/
+
+static inline uint32_t netdev_upper_gro_getseq(FAR const uint8_t *seqno)
+{
+  return ((uint32_t)seqno[0] << 24) | ((uint32_t)seqno[1] << 16) |
+         ((uint32_t)seqno[2] << 8) | seqno[3];
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_hdrlen
+ *
+ * Description:
+ *   Check whether a received packet is a plain TCP data segment that GRO
+ *   can coalesce, and return the length of its IP and TCP headers.
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *   pkt - The received packet
+ *
+ * Returned Value:
+ *   The header length, or zero if the packet has to go up on its own.
+ *
+ ****************************************************************************/
+
+static unsigned int netdev_upper_gro_hdrlen(FAR struct net_driver_s *dev,
+                                            FAR netpkt_t *pkt)
+{
+  FAR uint8_t *l3 = IOB_DATA(pkt);
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int iphdrlen;
+  unsigned int hdrlen;
+  unsigned int iplen;
+
+  /* Only untagged IP frames are considered */
+
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_DRIVERS_IEEE80211)
+      {
+        FAR struct eth_hdr_s *eth =
+          (FAR struct eth_hdr_s *)(l3 - NET_LL_HDRLEN(dev));
+
+        if (eth->type != HTONS(ETHTYPE_IP) &&
+            eth->type != HTONS(ETHTYPE_IP6))
+          {
+            return 0;
+          }
+      }
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      break;
+#endif
+    default:
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((l3[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)l3;
+
+      /* No IP options and no fragments */
+
+      if (pkt->io_len < IPv4_HDRLEN + TCP_HDRLEN ||
+          ipv4->vhl != (IPv4_VERSION | (IPv4_HDRLEN >> 2)) ||
+          ipv4->proto != IP_PROTO_TCP ||
+          (((ipv4->ipoffset[0] << 8) | ipv4->ipoffset[1]) &
+           ~IP_FLAG_DONTFRAG) != 0)
+        {
+          return 0;
+        }
+
+#ifdef CONFIG_NET_IPV4_CHECKSUMS
+      /* The IPv4 header is rewritten on coalescing, check it now */
+
+      if (ipv4_chksum(ipv4) != 0xffff)
+        {
+          return 0;
+        }
+#endif
+
+      iplen = ((uint16_t)ipv4->len[0] << 8) + ipv4->len[1];
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)l3;
+
+      /* No extension headers */
+
+      if (pkt->io_len < IPv6_HDRLEN + TCP_HDRLEN ||
+          ipv6->proto != IP_PROTO_TCP)
+        {
+          return 0;
+        }
+
+      iplen = IPv6_HDRLEN + ((uint16_t)ipv6->len[0] << 8) + ipv6->len[1];
+    }
+  else
+#endif
+    {
+      return 0;
+    }
+
+  iphdrlen = netdev_upper_gro_iphdrlen(l3);
+  tcp      = (FAR struct tcp_hdr_s *)(l3 + iphdrlen);
+  hdrlen   = iphdrlen + ((tcp->tcpoffset >> 4) << 2);
+
+  /* Plain data segments only (ACK, maybe PSH, nothing else), with all the
+   * headers in the first buffer and no link layer padding.
+   */
+
+  if ((tcp->flags & ~TCP_PSH) != TCP_ACK ||
+      hdrlen < iphdrlen + TCP_HDRLEN || hdrlen > pkt->io_len ||
+      hdrlen >= iplen || iplen != pkt->io_pktlen)
+    {
+      return 0;
+    }
+
+  return hdrlen;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_add
+ *
+ * Description:
+ *   One's complement addition of two partial checksums.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+static inline uint16_t netdev_upper_gro_add(uint16_t sum1, uint16_t sum2)
+{
+  uint32_t sum = (uint32_t)sum1 + sum2;
+
+  return (uint16_t)((sum & 0xffff) + (sum >> 16));
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_phdrsum
+ *
+ * Description:
+ *   Sum the TCP pseudo header of a packet with 'tcplen' bytes of TCP header
+ *   and payload.
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_upper_gro_phdrsum(FAR uint8_t *l3,
+                                         unsigned int tcplen)
+{
+#ifdef CONFIG_NET_IPv4
+  if ((l3[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)l3;
+
+      return chksum(tcplen + IP_PROTO_TCP, (FAR uint8_t *)ipv4->srcipaddr,
+                    2 * sizeof(in_addr_t));
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)l3;
+
+      return chksum(tcplen + IP_PROTO_TCP, (FAR uint8_t *)ipv6->srcipaddr,
+                    2 * sizeof(net_ipv6addr_t));
+    }
+#endif
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_paysum
+ *
+ * Description:
+ *   Derive the checksum over the TCP payload of a segment from its headers
+ *   alone: pseudo header, TCP header (including its checksum field) and
+ *   payload sum up to 0xffff in an intact segment.  A corrupted segment
+ *   yields a wrong value, which makes the checksum of the coalesced packet
+ *   fail in tcp_input().
+ *
+ ****************************************************************************/
+
+static uint16_t netdev_upper_gro_paysum(FAR netpkt_t *pkt,
+                                        unsigned int hdrlen)
+{
+  FAR uint8_t *l3 = IOB_DATA(pkt);
+  unsigned int iphdrlen = netdev_upper_gro_iphdrlen(l3);
+  uint16_t sum;
+
+  sum = netdev_upper_gro_phdrsum(l3, pkt->io_pktlen - iphdrlen);
+  sum = chksum(sum, l3 + iphdrlen, hdrlen - iphdrlen);
+  return (uint16_t)~sum;
+}
+#endif /* CONFIG_NET_TCP_CHECKSUMS */
+
+/****************************************************************************
+ * Name: netdev_upper_gro_match
+ *
+ * Description:
+ *   Check whether a segment directly continues the coalesced packet: same
+ *   flow, same header layout, next in sequence and room left.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_match(FAR struct net_driver_s *dev,
+                                   FAR struct netdev_upper_gro_s *gro,
+                                   FAR netpkt_t *pkt, unsigned int hdrlen)
+{
+  FAR uint8_t *l3 = IOB_DATA(gro->pkt);
+  FAR uint8_t *nl3 = IOB_DATA(pkt);
+  unsigned int iphdrlen = netdev_upper_gro_iphdrlen(l3);
+  FAR struct tcp_hdr_s *tcp = (FAR struct tcp_hdr_s *)(l3 + iphdrlen);
+  FAR struct tcp_hdr_s *ntcp = (FAR struct tcp_hdr_s *)(nl3 + iphdrlen);
+
+  if (hdrlen != gro->hdrlen ||
+      (l3[0] & IP_VERSION_MASK) != (nl3[0] & IP_VERSION_MASK) ||
+      (tcp->flags & TCP_PSH) != 0 ||
+      NET_LL_HDRLEN(dev) + gro->pkt->io_pktlen + pkt->io_pktlen - hdrlen >
+      UINT16_MAX)
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv4
+  if ((l3[0] & IP_VERSION_MASK) == IPv4_VERSION)
+    {
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)l3;
+      FAR struct ipv4_hdr_s *nipv4 = (FAR struct ipv4_hdr_s *)nl3;
+
+      if (ipv4->tos != nipv4->tos || ipv4->ttl != nipv4->ttl ||
+          memcmp(ipv4->srcipaddr, nipv4->srcipaddr,
+                 2 * sizeof(in_addr_t)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
+    {
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)l3;
+      FAR struct ipv6_hdr_s *nipv6 = (FAR struct ipv6_hdr_s *)nl3;
+
+      if (memcmp(ipv6, nipv6, offsetof(struct ipv6_hdr_s, len)) != 0 ||
+          ipv6->ttl != nipv6->ttl ||
+          memcmp(ipv6->srcipaddr, nipv6->srcipaddr,
+                 2 * sizeof(net_ipv6addr_t)) != 0)
+        {
+          return false;
+        }
+    }
+#endif
+
+  /* Same ports, acknowledgement, window and options, contiguous data */
+
+  return tcp->srcport == ntcp->srcport &&
+         tcp->destport == ntcp->destport &&
+         memcmp(tcp->ackno, ntcp->ackno, 4) == 0 &&
+         memcmp(tcp->wnd, ntcp->wnd, 2) == 0 &&
+         memcmp(tcp->optdata, ntcp->optdata,
+                hdrlen - iphdrlen - TCP_HDRLEN) == 0 &&
+         netdev_upper_gro_getseq(ntcp->seqno) ==
+         netdev_upper_gro_getseq(tcp->seqno) + gro->pkt->io_pktlen - hdrlen;
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_flush
+ *
+ * Description:
+ *   Fix up the headers of the coalesced packet and pass it into the stack.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static void netdev_upper_gro_flush(FAR struct netdev_upperhalf_s *upper,
+                                   FAR struct netdev_upper_gro_s *gro)
+{
+  FAR netpkt_t *pkt = gro->pkt;
+  FAR uint8_t *l3;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  FAR struct tcp_hdr_s *tcp;
+  unsigned int iphdrlen;
+  uint16_t sum;
+#endif
+
+  if (pkt == NULL)
+    {
+      return;
+    }
+
+  gro->pkt = NULL;
+  if (gro->nsegs > 1)
+    {
+      l3 = IOB_DATA(pkt);
+
+#ifdef CONFIG_NET_IPv4
+      if ((l3[0] & IP_VERSION_MASK) == IPv4_VERSION)
+        {
+          FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)l3;
+
+          ipv4->len[0]   = pkt->io_pktlen >> 8;
+          ipv4->len[1]   = pkt->io_pktlen & 0xff;
+          ipv4->ipchksum = 0;
+          ipv4->ipchksum = ~ipv4_chksum(ipv4);
+        }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+      if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
+        {
+          FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)l3;
+
+          ipv6->len[0] = (pkt->io_pktlen - IPv6_HDRLEN) >> 8;
+          ipv6->len[1] = (pkt->io_pktlen - IPv6_HDRLEN) & 0xff;
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      iphdrlen       = netdev_upper_gro_iphdrlen(l3);
+      tcp            = (FAR struct tcp_hdr_s *)(l3 + iphdrlen);
+      tcp->tcpchksum = 0;
+
+      sum = netdev_upper_gro_phdrsum(l3, pkt->io_pktlen - iphdrlen);
+      sum = chksum(sum, (FAR uint8_t *)tcp, gro->hdrlen - iphdrlen);
+      sum = netdev_upper_gro_add(sum, gro->sum);
+      tcp->tcpchksum = HTONS((uint16_t)~sum);
+#endif
+    }
+
+  netdev_upper_input(upper, pkt);
+}
+
+/****************************************************************************
+ * Name: netdev_upper_gro_receive
+ *
+ * Description:
+ *   Offer a received packet to GRO.  A segment continuing the coalesced
+ *   packet is appended to it; any other packet ends the batch, and a new
+ *   TCP data segment starts the next one.
+ *
+ * Returned Value:
+ *   true if GRO took the packet, false if the caller has to pass it into
+ *   the stack itself.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+static bool netdev_upper_gro_receive(FAR struct netdev_upperhalf_s *upper,
+                                     FAR struct netdev_upper_gro_s *gro,
+                                     FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+  unsigned int hdrlen = netdev_upper_gro_hdrlen(dev, pkt);
+  FAR struct tcp_hdr_s *tcp;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  uint16_t sum;
+#endif
+
+  if (hdrlen == 0 || gro->pkt == NULL ||
+      !netdev_upper_gro_match(dev, gro, pkt, hdrlen))
+    {
+      netdev_upper_gro_flush(upper, gro);
+      if (hdrlen == 0)
+        {
+          return false;
+        }
+
+      gro->pkt    = pkt;
+      gro->hdrlen = hdrlen;
+      gro->nsegs  = 1;
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+      gro->sum    = netdev_upper_gro_paysum(pkt, hdrlen);
+#endif
+      return true;
+    }
+
+#ifdef CONFIG_NET_TCP_CHECKSUMS
+  /* Data appended at an odd offset contributes its byte swapped sum */
+
+  sum = netdev_upper_gro_paysum(pkt, hdrlen);
+  if (((gro->pkt->io_pktlen - hdrlen) & 1) != 0)
+    {
+      sum = (uint16_t)((sum << 8) | (sum >> 8));
+    }
+
+  gro->sum = netdev_upper_gro_add(gro->sum, sum);
+#endif
+
+  /* A PSH on the last segment carries over and ends the batch */
+
+  tcp = (FAR struct tcp_hdr_s *)
+    (IOB_DATA(pkt) + netdev_upper_gro_iphdrlen(IOB_DATA(pkt)));
+  if ((tcp->flags & TCP_PSH) != 0)
+    {
+      tcp = (FAR struct tcp_hdr_s *)(IOB_DATA(gro->pkt) +
+             netdev_upper_gro_iphdrlen(IOB_DATA(gro->pkt)));
+      tcp->flags |= TCP_PSH;
+    }
+
+  /* Append the payload and give back the RX quota of the absorbed frame */
+
+  iob_concat(gro->pkt, iob_trimhead(pkt, hdrlen));
+  atomic_fetch_add(&upper->lower->quota[NETPKT_RX], 1);
+  gro->nsegs++;
+  return true;
+}
+#endif /* CONFIG_NETDEV_GRO */
+
+/****************************************************************************
+ * Name: netdev_upper_kick
+ *
+ * Description:
+ *   Wake up the work thread of a CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_WORK_THREAD
+static inline void netdev_upper_kick(FAR struct netdev_upperhalf_s *upper,
+                                     int cpu)
+{
+  int semcount;
+
+  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
+      semcount <= 0)
+    {
+      nxsem_post(&upper->sem[cpu]);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netdev_upper_flow_cpu
+ *
+ * Description:
+ *   Look up the CPU a received TCP/UDP packet is steered to in software.
+ *   The hash is the one netdev_notify_recvcpu() computed for the socket,
+ *   with the local end of the flow (our destination) first.
+ *
+ * Input Parameters:
+ *   upper - Reference to the upper half driver structure
+ *   pkt   - The received packet
+ *
+ * Returned Value:
+ *   The CPU, or a negative value if the packet is not steered.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+static int netdev_upper_flow_cpu(FAR struct netdev_upperhalf_s *upper,
+                                 FAR netpkt_t *pkt)
+{
+  FAR struct net_driver_s *dev = &upper->lower->netdev;
+  FAR uint8_t *l3 = IOB_DATA(pkt);
+  FAR uint16_t *ports;
+  uint32_t hash;
+
+  switch (dev->d_lltype)
+    {
+#ifdef CONFIG_NET_ETHERNET
+    case NET_LL_ETHERNET:
+#endif
+#ifdef CONFIG_DRIVERS_IEEE80211
+    case NET_LL_IEEE80211:
+#endif
+#if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_DRIVERS_IEEE80211)
+      {
+        FAR struct eth_hdr_s *eth =
+          (FAR struct eth_hdr_s *)(l3 - NET_LL_HDRLEN(dev));
+
+        if (eth->type != HTONS(ETHTYPE_IP) &&
+            eth->type != HTONS(ETHTYPE_IP6))
+          {
+            return -1;
+          }
+      }
+      break;
+#endif
+#ifdef CONFIG_NET_MBIM
+    case NET_LL_MBIM:
+      break;
+#endif
+    default:
+      return -1;
+    }
+
 #ifdef CONFIG_NET_IPv4
-  if (eth_hdr->type == HTONS(ETHTYPE_IP))
+  if ((l3[0] & IP_VERSION_MASK) == IPv4_VERSION)
     {
-      ninfo("IPv4 frame\n");
-      NETDEV_RXIPV4(dev);
-
-      /* Receive an IPv4 packet from the network device */
+      FAR struct ipv4_hdr_s *ipv4 = (FAR struct ipv4_hdr_s *)l3;
+      unsigned int hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+      in_addr_t laddr;
+      in_addr_t raddr;
 
-      ipv4_input(dev);
-    }
-  else
-#endif
-#ifdef CONFIG_NET_IPv6
-  if (eth_hdr->type == HTONS(ETHTYPE_IP6))
-    {
-      ninfo("IPv6 frame\n");
-      NETDEV_RXIPV6(dev);
+      /* Fragments carry no ports, leave them where they arrived */
 
-      /* Give the IPv6 packet to the network layer */
+      if (pkt->io_len < hdrlen + 4 ||
+          (ipv4->proto != IP_PROTO_TCP && ipv4->proto != IP_PROTO_UDP) ||
+          (((ipv4->ipoffset[0] << 8) | ipv4->ipoffset[1]) &
+           ~IP_FLAG_DONTFRAG) != 0)
+        {
+          return -1;
+        }
 
-      ipv6_input(dev);
+      ports = (FAR uint16_t *)(l3 + hdrlen);
+      laddr = net_ip4addr_conv32(ipv4->destipaddr);
+      raddr = net_ip4addr_conv32(ipv4->srcipaddr);
+      hash  = netdev_rss_hash(PF_INET, &laddr, ports[1], &raddr, ports[0]);
     }
   else
 #endif
-#ifdef CONFIG_NET_ARP
-  if (eth_hdr->type == HTONS(ETHTYPE_ARP))
+#ifdef CONFIG_NET_IPv6
+  if ((l3[0] & IP_VERSION_MASK) == IPv6_VERSION)
     {
-      ninfo("ARP frame\n");
-      NETDEV_RXARP(dev);
+      FAR struct ipv6_hdr_s *ipv6 = (FAR struct ipv6_hdr_s *)l3;
 
-      /* Handle ARP packet */
+      if (pkt->io_len < IPv6_HDRLEN + 4 ||
+          (ipv6->proto != IP_PROTO_TCP && ipv6->proto != IP_PROTO_UDP))
+        {
+          return -1;
+        }
 
-      arp_input(dev);
+      ports = (FAR uint16_t *)(l3 + IPv6_HDRLEN);
+      hash  = netdev_rss_hash(PF_INET6, ipv6->destipaddr, ports[1],
+                              ipv6->srcipaddr, ports[0]);
     }
   else
 #endif
     {
-      ninfo("INFO: Dropped, Unknown type: %04x\n", eth_hdr->type);
-      NETDEV_RXDROPPED(dev);
-      dev->d_len = 0;
+      return -1;
     }
 
-  /* If the above function invocation resulted in data
-   * that should be sent out on the network,
-   * the field d_len will set to a value > 0.
-   */
-
-  if (dev->d_len > 0)
-    {
-      /* And queue the packet for sending later.
-       * Note: RX is tried before TX, so we don't need to call txavail here.
-       */
-
-      netdev_upper_queue_tx(dev);
-    }
+  hash %= CONFIG_NETDEV_RSS_FLOWS;
+  return upper->flowcpu[hash] == NETDEV_RSS_NOCPU ? -1 :
+         upper->flowcpu[hash];
 }
-#endif
 
 /****************************************************************************
- * Name: ip_input
+ * Name: netdev_upper_steer
  *
  * Description:
- *   Handle L3 packet input.
+ *   Hand a received packet over to the CPU its socket receives on, if that
+ *   is not the current one.
  *
- * Input Parameters:
- *   dev - Reference to the NuttX network driver state structure
+ * Returned Value:
+ *   True if the packet was queued to another CPU.
  *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_MBIM
-static void ip_input(FAR struct net_driver_s *dev)
+static bool netdev_upper_steer(FAR struct netdev_upperhalf_s *upper,
+                               FAR netpkt_t *pkt)
 {
-  /* We only accept IP packets of the configured type */
+  int cpu = netdev_upper_flow_cpu(upper, pkt);
 
-#ifdef CONFIG_NET_IPv4
-  if ((IPv4BUF->vhl & IP_VERSION_MASK) == IPv4_VERSION)
+  if (cpu < 0 || cpu == this_cpu() ||
+      iob_tryadd_queue(pkt, &upper->backlog[cpu]) < 0)
     {
-      ninfo("IPv4 frame\n");
-      NETDEV_RXIPV4(dev);
-
-      /* Receive an IPv4 packet from the network device */
-
-      ipv4_input(dev);
+      return false;
     }
-  else
-#endif
-#ifdef CONFIG_NET_IPv6
-  if ((IPv6BUF->vtc & IP_VERSION_MASK) == IPv6_VERSION)
-    {
-      ninfo("IPv6 frame\n");
-      NETDEV_RXIPV6(dev);
 
-      /* Give the IPv6 packet to the network layer */
+  netdev_upper_kick(upper, cpu);
+  return true;
+}
 
-      ipv6_input(dev);
-    }
-  else
-#endif
-    {
-      ninfo("INFO: Dropped, Unknown type\n");
-      NETDEV_RXDROPPED(dev);
-      dev->d_len = 0;
-    }
+/****************************************************************************
+ * Name: netdev_upper_backlog_work
+ *
+ * Description:
+ *   Process the packets other CPUs steered to this one.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
 
-  /* If the above function invocation resulted in data
-   * that should be sent out on the network,
-   * the field d_len will set to a value > 0.
-   */
+static void netdev_upper_backlog_work(FAR struct netdev_upperhalf_s *upper,
+                                      int cpu)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  FAR netpkt_t *pkt;
 
-  if (dev->d_len > 0)
+  while ((pkt = iob_remove_queue(&upper->backlog[cpu])) != NULL)
     {
-      /* And queue the packet for sending later.
-       * Note: RX is tried before TX, so we don't need to call txavail here.
-       */
+      if (!IFF_IS_UP(lower->netdev.d_flags))
+        {
+          NETDEV_RXDROPPED(&lower->netdev);
+          netpkt_free(lower, pkt, NETPKT_RX);
+          continue;
+        }
 
-      netdev_upper_queue_tx(dev);
+      netdev_upper_input(upper, pkt);
     }
 }
-#endif
+
+#endif /* CONFIG_NETDEV_RSS_FLOWS > 0 */
 
 /****************************************************************************
  * Function: netdev_upper_rxpoll_work
@@ -590,21 +1584,28 @@ static void ip_input(FAR struct net_driver_s *dev)
  *
  * Input Parameters:
  *   upper - Reference to the upper half driver structure
+ *   queue - The RX queue to drain
  *
  * Assumptions:
  *   Called with the network locked.
  *
  ****************************************************************************/
 
-static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
+static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper,
+                                     int queue)
 {
   FAR struct netdev_lowerhalf_s *lower = upper->lower;
   FAR struct net_driver_s       *dev   = &lower->netdev;
   FAR netpkt_t                  *pkt;
+#ifdef CONFIG_NETDEV_GRO
+  struct netdev_upper_gro_s      gro;
+
+  gro.pkt = NULL;
+#endif
 
   /* Loop while receive() successfully retrieves valid Ethernet frames. */
 
-  while ((pkt = lower->ops->receive(lower)) != NULL)
+  while ((pkt = netdev_upper_receive(lower, queue)) != NULL)
     {
       if (!IFF_IS_UP(dev->d_flags))
         {
@@ -615,72 +1616,91 @@ static void netdev_upper_rxpoll_work(FAR struct netdev_upperhalf_s *upper)
           continue;
         }
 
-      netpkt_put(dev, pkt, NETPKT_RX);
       NETDEV_RXPACKETS(dev);
 
-#ifdef CONFIG_NET_PKT
-      /* When packet sockets are enabled, feed the frame into the tap */
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+      /* Move the flow to the CPU its socket receives on */
 
-      pkt_input(dev);
+      if (upper->swsteer && netdev_upper_steer(upper, pkt))
+        {
+          continue;
+        }
 #endif
 
-      switch (dev->d_lltype)
+#ifdef CONFIG_NETDEV_GRO
+      /* Coalesce consecutive segments of a TCP flow before tcp_input() */
+
+      if (netdev_upper_gro_receive(upper, &gro, pkt))
         {
-#ifdef CONFIG_NET_LOOPBACK
-        case NET_LL_LOOPBACK:
-#endif
-#ifdef CONFIG_NET_ETHERNET
-        case NET_LL_ETHERNET:
-#endif
-#ifdef CONFIG_DRIVERS_IEEE80211
-        case NET_LL_IEEE80211:
-#endif
-#if defined(CONFIG_NET_LOOPBACK) || defined(CONFIG_NET_ETHERNET) || \
-    defined(CONFIG_DRIVERS_IEEE80211)
-          eth_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_MBIM
-        case NET_LL_MBIM:
-          ip_input(dev);
-          break;
-#endif
-#ifdef CONFIG_NET_CAN
-        case NET_LL_CAN:
-          ninfo("CAN frame");
-          can_input(dev);
-          break;
-#endif
-        default:
-          nerr("Unknown link type %d\n", dev->d_lltype);
-          break;
+          continue;
         }
+#endif
+
+      netdev_upper_input(upper, pkt);
     }
+
+#ifdef CONFIG_NETDEV_GRO
+  netdev_upper_gro_flush(upper, &gro);
+#endif
 }
 
 /****************************************************************************
- * Name: netdev_upper_work
+ * Name: netdev_upper_poll
  *
  * Description:
- *   Perform an out-of-cycle poll on a dedicated thread or the worker thread.
+ *   Perform an out-of-cycle poll of the queues bound to a CPU.
  *
  * Input Parameters:
- *   arg - Reference to the upper half driver structure (cast to void *)
+ *   upper - Reference to the upper half driver structure
+ *   cpu   - The CPU the poll runs on
  *
  ****************************************************************************/
 
-static void netdev_upper_work(FAR void *arg)
+static void netdev_upper_poll(FAR struct netdev_upperhalf_s *upper, int cpu)
 {
-  FAR struct netdev_upperhalf_s *upper = arg;
+  int nqueues = NETDEV_NQUEUES(upper->lower);
+  int queue;
 
   /* RX may release quota and driver buffer, so do RX first. */
 
   net_lock();
-  netdev_upper_rxpoll_work(upper);
+
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+  netdev_upper_backlog_work(upper, cpu);
+#endif
+
+  /* A single queue is drained by whichever CPU was notified, the queues of
+   * a multi-queue device only by the CPU they are bound to.
+   */
+
+  for (queue = nqueues > 1 ? cpu : 0; queue < nqueues;
+       queue += NETDEV_THREAD_COUNT)
+    {
+      netdev_upper_rxpoll_work(upper, queue);
+    }
+
   netdev_upper_txavail_work(upper);
   net_unlock();
 }
 
+/****************************************************************************
+ * Name: netdev_upper_work
+ *
+ * Description:
+ *   Perform an out-of-cycle poll on the worker thread.
+ *
+ * Input Parameters:
+ *   arg - Reference to the upper half driver structure (cast to void *)
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETDEV_WORK_THREAD
+static void netdev_upper_work(FAR void *arg)
+{
+  netdev_upper_poll(arg, 0);
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wait
  *
@@ -727,7 +1747,7 @@ static int netdev_upper_loop(int argc, FAR char *argv[])
   while (netdev_upper_wait(&upper->sem[cpu]) == OK &&
          upper->tid[cpu] != INVALID_PROCESS_ID)
     {
-      netdev_upper_work(upper);
+      netdev_upper_poll(upper, cpu);
     }
 
   nwarn("WARNING: Netdev work thread quitting.");
@@ -752,14 +1772,11 @@ static inline void netdev_upper_queue_work(FAR struct net_driver_s *dev)
   FAR struct netdev_upperhalf_s *upper = dev->d_private;
 
 #ifdef CONFIG_NETDEV_WORK_THREAD
-  int cpu = this_cpu();
-  int semcount;
-
-  if (nxsem_get_value(&upper->sem[cpu], &semcount) == OK &&
-      semcount <= 0)
-    {
-      nxsem_post(&upper->sem[cpu]);
-    }
+#  ifdef CONFIG_NETDEV_RSS
+  netdev_upper_kick(upper, this_cpu());
+#  else
+  netdev_upper_kick(upper, 0);
+#  endif
 #else
   if (work_available(&upper->work))
     {
@@ -1132,6 +2149,57 @@ static int netdev_upper_rmmac(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: netdev_upper_notify_recvcpu
+ *
+ * Description:
+ *   Handle SIOCNOTIFYRECVCPU: tell the driver which of its RX queues is
+ *   drained on the CPU of the flow, and steer the flow in software when
+ *   the driver cannot.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RSS
+static int netdev_upper_notify_recvcpu(FAR struct netdev_upperhalf_s *upper,
+                                       FAR struct netdev_rss_s *rss)
+{
+  FAR struct netdev_lowerhalf_s *lower = upper->lower;
+  int ret = -ENOTTY;
+
+  DEBUGASSERT(rss->cpu >= 0 && rss->cpu < NETDEV_THREAD_COUNT);
+
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  /* The queue of the same index is the first one bound to the CPU, the
+   * driver cannot help if no queue is drained there.
+   */
+
+  rss->queue = rss->cpu < NETDEV_NQUEUES(lower) ? rss->cpu : -1;
+  if (lower->ops->ioctl && (lower->nqueues <= 1 || rss->queue >= 0))
+#else
+  if (lower->ops->ioctl)
+#endif
+    {
+      ret = lower->ops->ioctl(lower, SIOCNOTIFYRECVCPU,
+                              (unsigned long)(uintptr_t)rss);
+    }
+
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+  if (ret < 0)
+    {
+      upper->flowcpu[rss->hash % CONFIG_NETDEV_RSS_FLOWS] = rss->cpu;
+      upper->swsteer = true;
+      ret = OK;
+    }
+  else
+    {
+      upper->flowcpu[rss->hash % CONFIG_NETDEV_RSS_FLOWS] = NETDEV_RSS_NOCPU;
+    }
+#endif
+
+  return ret;
+}
+#endif
+
 #ifdef CONFIG_NETDEV_IOCTL
 static int netdev_upper_ioctl(FAR struct net_driver_s *dev, int cmd,
                               unsigned long arg)
@@ -1150,6 +2218,14 @@ static int netdev_upper_ioctl(FAR struct net_driver_s *dev, int cmd,
     }
 #endif
 
+#ifdef CONFIG_NETDEV_RSS
+  if (cmd == SIOCNOTIFYRECVCPU)
+    {
+      return netdev_upper_notify_recvcpu(upper,
+                          (FAR struct netdev_rss_s *)((uintptr_t)arg));
+    }
+#endif
+
   if (lower->ops->ioctl)
     {
       return lower->ops->ioctl(lower, cmd, arg);
@@ -1195,6 +2271,14 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
       return -EINVAL;
     }
 
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  if (dev->nqueues > CONFIG_NETDEV_MAX_QUEUES || (dev->nqueues > 1 &&
+      (dev->ops->transmitq == NULL || dev->ops->receiveq == NULL)))
+    {
+      return -EINVAL;
+    }
+#endif
+
   if ((upper = netdev_upper_alloc(dev)) == NULL)
     {
       return -ENOMEM;
@@ -1212,6 +2296,16 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
   dev->netdev.d_private = upper;
 
+#ifdef CONFIG_NETDEV_GSO
+  /* TCP super-segments are split in netdev_upper_txpoll() */
+
+  dev->netdev.d_gso_maxsize = CONFIG_NETDEV_GSO_MAXSIZE;
+#endif
+
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+  memset(upper->flowcpu, NETDEV_RSS_NOCPU, sizeof(upper->flowcpu));
+#endif
+
   ret = netdev_register(&dev->netdev, lltype);
   if (ret < 0)
     {
@@ -1282,6 +2376,13 @@ int netdev_lower_unregister(FAR struct netdev_lowerhalf_s *dev)
     }
 #endif
 
+#if CONFIG_NETDEV_RSS_FLOWS > 0
+  for (i = 0; i < NETDEV_THREAD_COUNT; i++)
+    {
+      iob_free_queue(&upper->backlog[i]);
+    }
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
   iob_free_queue(&upper->txq);
 #endif
@@ -1363,6 +2464,55 @@ void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev)
 #endif
 }
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer about an RX packet is ready to read on
+ *   one queue of a multi-queue device.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The RX queue index
+ *
+ ****************************************************************************/
+
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue)
+{
+  DEBUGASSERT(queue >= 0 && queue < NETDEV_NQUEUES(dev));
+
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  netdev_upper_kick(dev->netdev.d_private, queue % NETDEV_THREAD_COUNT);
+#endif
+}
+
+/****************************************************************************
+ * Name: netdev_lower_txdone_queue
+ *
+ * Description:
+ *   Notifies the networking layer about a TX packet is sent on one queue of
+ *   a multi-queue device.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The TX queue index
+ *
+ ****************************************************************************/
+
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               int queue)
+{
+  DEBUGASSERT(queue >= 0 && queue < NETDEV_NQUEUES(dev));
+
+  NETDEV_TXDONE(&dev->netdev);
+#if CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD == 0
+  netdev_upper_kick(dev->netdev.d_private, queue % NETDEV_THREAD_COUNT);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_quota_load
  *
@@ -1407,7 +2557,13 @@ FAR netpkt_t *netpkt_alloc(FAR struct netdev_lowerhalf_s *dev,
       return NULL;
     }
 
-  pkt = iob_tryalloc(false);
+  /* Prefer a buffer holding a whole frame, so drivers see fewer chains,
+   * but never a smaller one than iob_tryalloc() would give: the drivers
+   * may DMA up to CONFIG_IOB_BUFSIZE bytes into it.
+   */
+
+  pkt = iob_tryalloc_fit_large(CONFIG_NET_LL_GUARDSIZE +
+                               NETDEV_PKTSIZE(&dev->netdev), false);
   if (pkt == NULL)
     {
       atomic_fetch_add(&dev->quota[type], 1);
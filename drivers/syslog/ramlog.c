@@ -26,6 +26,7 @@
 
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/param.h>
 
 #include <stdio.h>
 #include <stdint.h>
@@ -41,6 +42,8 @@
 #include <sys/boardctl.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/atomic.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/semaphore.h>
@@ -110,6 +113,29 @@ struct ramlog_dev_s
 #endif
 };
 
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+/* A line completed by a core, waiting for the drain CPU */
+
+struct ramlog_mark_s
+{
+  uint32_t          rm_pos;      /* Ring position just past the newline */
+  clock_t           rm_stamp;    /* perf_gettime() when it was written */
+};
+
+/* Per-core state shared with the drain CPU.  rs_markhead is only written
+ * by the owning core; rs_marktail and rs_tail only by the current owner of
+ * g_ramlog_drain_owner.
+ */
+
+struct ramlog_share_s
+{
+  atomic_uint       rs_markhead; /* Next mark to be written */
+  uint32_t          rs_marktail; /* Next mark to be drained */
+  uint32_t          rs_tail;     /* Ring position drained so far */
+  struct ramlog_mark_s rs_mark[CONFIG_RAMLOG_BMP_NMARKS];
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -159,13 +185,37 @@ static const struct file_operations g_ramlogfops =
  */
 
 #ifdef CONFIG_RAMLOG_SYSLOG
-#  ifdef RAMLOG_BUFFER_SECTION
+#  ifdef CONFIG_BMP
+#define MMAP_SHARE_VAR_INIT_SECTION         __attribute__((section(".data.Share.VAR_INIT"))) __attribute__ ((aligned (64)))
+#  endif
+
+#  if defined(CONFIG_RAMLOG_BMP_DRAIN)
+/* Each core logs into its own ring in shared memory so that the drain CPU
+ * can read them all.
+ */
+
+MMAP_SHARE_VAR_INIT_SECTION
+static uint32_t
+g_ramlog_sysbuffer[CONFIG_BMP_NCPUS][CONFIG_RAMLOG_BUFSIZE / 4];
+MMAP_SHARE_VAR_INIT_SECTION
+static struct ramlog_share_s g_ramlog_share[CONFIG_BMP_NCPUS];
+
+/* The CPU draining the rings: the flush worker of the drain CPU, or any
+ * core flushing on a crash.  -1 if none.
+ */
+
+MMAP_SHARE_VAR_INIT_SECTION
+static atomic_int g_ramlog_drain_owner = -1;
+
+#define g_sysbuffer g_ramlog_sysbuffer[up_cpu_index()]
+#  elif defined(RAMLOG_BUFFER_SECTION)
 static  uint32_t g_sysbuffer[CONFIG_RAMLOG_BUFSIZE / 4]
                        locate_data(RAMLOG_BUFFER_SECTION);
+#define g_sysbuffer this_cpu_var(g_sysbuffer)
 #  else
 static __percpu_bss uint32_t g_sysbuffer[CONFIG_RAMLOG_BUFSIZE / 4];
-#  endif
 #define g_sysbuffer this_cpu_var(g_sysbuffer)
+#  endif
 
 /* This is the device structure for the console or syslogging function.  It
  * must be statically initialized because the RAMLOG ramlog_putc function
@@ -175,8 +225,7 @@ static __percpu_bss uint32_t g_sysbuffer[CONFIG_RAMLOG_BUFSIZE / 4];
 static __percpu_bss struct ramlog_dev_s g_sysdev;
 #define g_sysdev this_cpu_var(g_sysdev)
 
-#ifdef CONFIG_BMP
-#define MMAP_SHARE_VAR_INIT_SECTION         __attribute__((section(".data.Share.VAR_INIT"))) __attribute__ ((aligned (64)))
+#if defined(CONFIG_BMP) && !defined(CONFIG_RAMLOG_BMP_DRAIN)
 MMAP_SHARE_VAR_INIT_SECTION
 volatile static spinlock_t g_ramlog_lock = SP_UNLOCKED;
 #endif
@@ -265,10 +314,217 @@ static void ramlog_bufferflush(FAR struct ramlog_dev_s *priv)
     }
 }
 
+/****************************************************************************
+ * Name: ramlog_bmp_mark
+ *
+ * Description:
+ *   Record the end of every line just added to the ring of this core so
+ *   that the drain CPU can merge it.  Called by the owning core with its
+ *   critical section held.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+static void ramlog_bmp_mark(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t len)
+{
+  FAR struct ramlog_share_s *share = &g_ramlog_share[up_cpu_index()];
+  FAR const char *end = buffer + len;
+  FAR const char *nl;
+  uint32_t start = priv->rl_header->rl_head - len;
+  uint32_t head;
+  clock_t stamp;
+
+  nl = memchr(buffer, '\n', len);
+  if (nl == NULL)
+    {
+      return;
+    }
+
+  head  = atomic_load_explicit(&share->rs_markhead, memory_order_relaxed);
+  stamp = perf_gettime();
+
+  do
+    {
+      FAR struct ramlog_mark_s *mark =
+        &share->rs_mark[head++ % CONFIG_RAMLOG_BMP_NMARKS];
+
+      mark->rm_pos   = start + (nl - buffer) + 1;
+      mark->rm_stamp = stamp;
+      nl = memchr(nl + 1, '\n', end - nl - 1);
+    }
+  while (nl != NULL);
+
+  /* Publish the marks, and the data before them, to the drain CPU */
+
+  atomic_store_explicit(&share->rs_markhead, head, memory_order_release);
+}
+
+/****************************************************************************
+ * Name: ramlog_bmp_output
+ *
+ * Description:
+ *   Write the ring of one core up to 'end' to the lower half.  Only called
+ *   by the owner of g_ramlog_drain_owner, so no lock is needed around
+ *   up_nputs().
+ *
+ ****************************************************************************/
+
+static void ramlog_bmp_output(int cpu, uint32_t end)
+{
+  FAR struct ramlog_share_s *share = &g_ramlog_share[cpu];
+  FAR struct ramlog_header_s *header =
+    (FAR struct ramlog_header_s *)g_ramlog_sysbuffer[cpu];
+  uint32_t bufsize = sizeof(g_ramlog_sysbuffer[cpu]) -
+                     sizeof(struct ramlog_header_s);
+  char buffer[CONFIG_SYSLOG_BUFSIZE];
+  uint32_t offset;
+  uint32_t size;
+
+  while ((int32_t)(end - share->rs_tail) > 0)
+    {
+      /* Skip what the core has already overwritten */
+
+      if (header->rl_head - share->rs_tail > bufsize)
+        {
+          share->rs_tail = header->rl_head - bufsize;
+          continue;
+        }
+
+      offset = share->rs_tail % bufsize;
+      size = MIN(end - share->rs_tail, bufsize - offset);
+      size = MIN(size, sizeof(buffer));
+
+      memcpy(buffer, header->rl_buffer + offset, size);
+
+      /* Drop the copy if the core wrapped over it in the meantime */
+
+      if (header->rl_head - share->rs_tail <= bufsize)
+        {
+          up_nputs(buffer, size);
+        }
+
+      share->rs_tail += size;
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_bmp_asserting
+ *
+ * Description:
+ *   Return true if another core is dumping its assertion (see
+ *   ramlog_flush_internal()).
+ *
+ ****************************************************************************/
+
+static bool ramlog_bmp_asserting(int cpu)
+{
+  return (g_assert_sync & 0xFFFF0000) == 0xDEAD0000 &&
+         ((g_assert_sync & 0xFFFF) & ~(1 << cpu)) != 0;
+}
+
+/****************************************************************************
+ * Name: ramlog_bmp_drain
+ *
+ * Description:
+ *   Write the complete lines of all cores in timestamp order.  If 'all' is
+ *   true, incomplete lines are written as well.  The caller must own
+ *   g_ramlog_drain_owner.
+ *
+ *   When called from the flush worker ('all' false), each line is written
+ *   with interrupts disabled, so that a crash flush on this CPU never finds
+ *   the bookkeeping half updated, and draining stops as soon as another
+ *   core starts dumping an assertion.
+ *
+ ****************************************************************************/
+
+static void ramlog_bmp_drain(bool all)
+{
+  FAR struct ramlog_share_s *share;
+  struct ramlog_mark_s best;
+  struct ramlog_mark_s mark;
+  irqstate_t flags = 0;
+  uint32_t markhead;
+  int bestcpu;
+  int cpu;
+
+  for (; ; )
+    {
+      if (!all)
+        {
+          flags = up_irq_save();
+          if (ramlog_bmp_asserting(up_cpu_index()))
+            {
+              up_irq_restore(flags);
+              break;
+            }
+        }
+
+      bestcpu = -1;
+
+      for (cpu = 0; cpu < CONFIG_BMP_NCPUS; cpu++)
+        {
+          share = &g_ramlog_share[cpu];
+          markhead = atomic_load_explicit(&share->rs_markhead,
+                                          memory_order_acquire);
+
+          /* Forget the marks that the core has already reused.  The lines
+           * behind them go out together with the oldest remaining one.
+           */
+
+          if (markhead - share->rs_marktail > CONFIG_RAMLOG_BMP_NMARKS)
+            {
+              share->rs_marktail = markhead - CONFIG_RAMLOG_BMP_NMARKS;
+            }
+
+          if (share->rs_marktail == markhead)
+            {
+              continue;
+            }
+
+          mark = share->rs_mark[share->rs_marktail %
+                                CONFIG_RAMLOG_BMP_NMARKS];
+          if (bestcpu < 0 || mark.rm_stamp < best.rm_stamp)
+            {
+              best    = mark;
+              bestcpu = cpu;
+            }
+        }
+
+      if (bestcpu >= 0)
+        {
+          ramlog_bmp_output(bestcpu, best.rm_pos);
+          g_ramlog_share[bestcpu].rs_marktail++;
+        }
+
+      if (!all)
+        {
+          up_irq_restore(flags);
+        }
+
+      if (bestcpu < 0)
+        {
+          break;
+        }
+    }
+
+  if (all)
+    {
+      for (cpu = 0; cpu < CONFIG_BMP_NCPUS; cpu++)
+        {
+          FAR struct ramlog_header_s *header =
+            (FAR struct ramlog_header_s *)g_ramlog_sysbuffer[cpu];
+
+          ramlog_bmp_output(cpu, header->rl_head);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: ramlog_copybuf
  ****************************************************************************/
-#ifdef CONFIG_RAMLOG_FLUSH_WORKER
+#if defined(CONFIG_RAMLOG_FLUSH_WORKER) && !defined(CONFIG_RAMLOG_BMP_DRAIN)
 
 void ramlog_flush_internal(FAR struct ramlog_dev_s *priv)
 {
@@ -340,9 +596,29 @@ void ramlog_flush_internal(FAR struct ramlog_dev_s *priv)
   leave_critical_section(flags);
 }
 
+#endif
+
+#ifdef CONFIG_RAMLOG_FLUSH_WORKER
 static void ramlog_flush_worker(FAR void *arg)
 {
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+  FAR struct ramlog_dev_s *priv = arg;
+  int owner = -1;
+
+  /* Poll the rings of all cores, unless a crash flush is draining them */
+
+  if (atomic_compare_exchange_strong(&g_ramlog_drain_owner, &owner,
+                                     up_cpu_index()))
+    {
+      ramlog_bmp_drain(false);
+      atomic_store(&g_ramlog_drain_owner, -1);
+    }
+
+  work_queue(LPWORK, &priv->rl_work, ramlog_flush_worker, priv,
+             RAMLOG_FLUSH_WORKER_TIMEOUT_TICKS);
+#else
   ramlog_flush_internal(arg);
+#endif
 }
 #endif
 
@@ -418,6 +694,13 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
 
   ramlog_copybuf(priv, buffer, buflen);
 
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+  if (priv == &g_sysdev)
+    {
+      ramlog_bmp_mark(priv, buffer, buflen);
+    }
+#endif
+
   /* Was anything written? */
 
   if (len > 0)
@@ -449,7 +732,7 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
               sched_unlock();
             }
         }
-#ifdef CONFIG_RAMLOG_FLUSH_WORKER
+#if defined(CONFIG_RAMLOG_FLUSH_WORKER) && !defined(CONFIG_RAMLOG_BMP_DRAIN)
       else if (priv == &g_sysdev && OSINIT_MM_READY())
         {
           if (header->rl_head - priv->rl_tail >= CONFIG_RAMLOG_POLLTHRESHOLD)
@@ -792,7 +1075,37 @@ int ramlog_flush(FAR syslog_channel_t *channel)
 #ifdef CONFIG_RAMLOG_SYSLOG
   ramlog_syslog_initialize();
 #endif
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+  int cpu = up_cpu_index();
+  int owner;
+
+  /* Let the other asserting cores finish first, as ramlog_flush_internal()
+   * does, then wait for the current drain to complete.  If this CPU already
+   * owns the drain, we interrupted its flush worker, which is between two
+   * lines since it writes each one with interrupts disabled.
+   */
+
+  if ((g_assert_sync & 0xFFFF0000) == 0xDEAD0000)
+    {
+      while ((g_assert_sync & 0xFFFF) & ~(1 << cpu));
+    }
+
+  do
+    {
+      owner = -1;
+    }
+  while (!atomic_compare_exchange_strong(&g_ramlog_drain_owner, &owner,
+                                         cpu) && owner != cpu);
+
+  ramlog_bmp_drain(true);
+
+  if (owner != cpu)
+    {
+      atomic_store(&g_ramlog_drain_owner, -1);
+    }
+#else
   ramlog_flush_internal(&g_sysdev);
+#endif
   return 0;
 }
 #endif
@@ -867,6 +1180,16 @@ void ramlog_syslog_register(void)
   ramlog_syslog_initialize();
 
   register_driver(CONFIG_SYSLOG_DEVPATH, &g_ramlogfops, 0666, &g_sysdev);
+
+#ifdef CONFIG_RAMLOG_BMP_DRAIN
+  /* Start the drain agent that writes the logs of all cores */
+
+  if (up_cpu_index() == CONFIG_RAMLOG_BMP_DRAIN_CPU)
+    {
+      work_queue(LPWORK, &g_sysdev.rl_work, ramlog_flush_worker,
+                 &g_sysdev, RAMLOG_FLUSH_WORKER_TIMEOUT_TICKS);
+    }
+#endif
 }
 #endif
 
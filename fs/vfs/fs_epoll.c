@@ -40,6 +40,7 @@
 #include <nuttx/list.h>
 #include <nuttx/mutex.h>
 #include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
 
 #include "inode/inode.h"
 #include "fs_heap.h"
@@ -51,8 +52,10 @@
 struct epoll_node_s
 {
   struct list_node         node;
+  struct list_node         rdnode;  /* Link in the ready list */
   epoll_data_t             data;
-  bool                     notified;
+  bool                     ready;   /* Whether the node is in the ready list */
+  pollevent_t              revents; /* Events collected by the callback */
   struct pollfd            pfd;
   FAR struct epoll_head_s *eph;
 };
@@ -65,13 +68,24 @@ struct epoll_head_s
   int                   crefs;
   mutex_t               lock;
   sem_t                 sem;
+  spinlock_t            rdlock;   /* Protect the ready list, the poll
+                                   * callback may run in interrupt context.
+                                   */
+  struct list_node      rdlist;   /* The ready list, store all the epoll
+                                   * node whose poll callback fired since
+                                   * the last epoll_wait, epoll_wait only
+                                   * drains this list.
+                                   */
   struct list_node      setup;    /* The setup list, store all the setuped
-                                   * epoll node.
+                                   * epoll node, the poll stays installed
+                                   * from epoll_ctl(ADD) until
+                                   * epoll_ctl(DEL).
                                    */
-  struct list_node      teardown; /* The teardown list, store all the epoll
-                                   * node notified after epoll_wait finish,
-                                   * these epoll node should be setup again
-                                   * to check the pending poll notification.
+  struct list_node      teardown; /* The teardown list, store all the level
+                                   * triggered epoll node reported by the
+                                   * last epoll_wait, these epoll node
+                                   * should be setup again to check whether
+                                   * the events are still pending.
                                    */
   struct list_node      oneshot;  /* The oneshot list, store all the epoll
                                    * node notified after epoll_wait and with
@@ -240,6 +254,8 @@ static int epoll_do_create(int size, int flags)
 
   epn = (FAR epoll_node_t *)(eph + 1);
 
+  spin_lock_init(&eph->rdlock);
+  list_initialize(&eph->rdlist);
   list_initialize(&eph->setup);
   list_initialize(&eph->teardown);
   list_initialize(&eph->oneshot);
@@ -266,17 +282,49 @@ static int epoll_do_create(int size, int flags)
   return fd;
 }
 
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove the epoll node from the ready list and drop the events collected
+ *   so far, the caller must have torn down the poll or be about to set it
+ *   up again.
+ *
+ * Input Parameters:
+ *   eph       - The epoll head pointer
+ *   epn       - The epoll node pointer
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR epoll_head_t *eph, FAR epoll_node_t *epn)
+{
+  irqstate_t flags = spin_lock_irqsave(&eph->rdlock);
+
+  if (epn->ready)
+    {
+      list_delete(&epn->rdnode);
+      epn->ready = false;
+    }
+
+  epn->revents = 0;
+  spin_unlock_irqrestore(&eph->rdlock, flags);
+}
+
 /****************************************************************************
  * Name: epoll_setup
  *
  * Description:
- *   Setup all the fd.
+ *   Setup again the level triggered fd reported by the last epoll_wait.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
  *
  * Returned Value:
- *   Positive on success, negative on fail
+ *   Positive if the ready list isn't empty, zero if it is empty, negative
+ *   on fail
  *
  ****************************************************************************/
 
@@ -298,20 +346,22 @@ static int epoll_setup(FAR epoll_head_t *eph)
        * cover the situation several poll event pending on one fd.
        */
 
-      epn->notified    = false;
       epn->pfd.revents = 0;
       ret = poll_fdsetup(epn->pfd.fd, &epn->pfd, true);
       if (ret < 0)
         {
           ferr("epoll setup failed, fd=%d, events=%08" PRIx32 ", ret=%d\n",
                epn->pfd.fd, epn->pfd.events, ret);
-          break;
+          goto out;
         }
 
       list_delete(&epn->node);
       list_add_tail(&eph->setup, &epn->node);
     }
 
+  ret = !list_is_empty(&eph->rdlist);
+
+out:
   nxmutex_unlock(&eph->lock);
   return ret;
 }
@@ -320,8 +370,10 @@ static int epoll_setup(FAR epoll_head_t *eph)
  * Name: epoll_teardown
  *
  * Description:
- *   Teardown all the notifed fd and check the notified fd's event with user
- *   expected event.
+ *   Drain the ready list into the user's event array.  The level triggered
+ *   fd are torn down and moved to the teardown list to be checked again by
+ *   the next epoll_wait, the EPOLLONESHOT fd are torn down and parked in
+ *   the oneshot list, the EPOLLET fd stay installed.
  *
  * Input Parameters:
  *   eph       - The epoll head pointer
@@ -337,45 +389,45 @@ static int epoll_setup(FAR epoll_head_t *eph)
 static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
                           int maxevents)
 {
-  FAR epoll_node_t *tepn;
   FAR epoll_node_t *epn;
+  pollevent_t revents;
+  irqstate_t flags;
   int i = 0;
 
   nxmutex_lock(&eph->lock);
 
-  list_for_every_entry_safe(&eph->setup, epn, tepn, epoll_node_t, node)
+  flags = spin_lock_irqsave(&eph->rdlock);
+  while (i < maxevents && !list_is_empty(&eph->rdlist))
     {
-      /* Only check the notifed fd */
-
-      if (!epn->notified)
-        {
-          continue;
-        }
+      epn = container_of(list_remove_head(&eph->rdlist),
+                         epoll_node_t, rdnode);
+      epn->ready   = false;
+      revents      = epn->revents;
+      epn->revents = 0;
+      spin_unlock_irqrestore(&eph->rdlock, flags);
 
-      /* Teradown all the notified fd */
+      evs[i].data     = epn->data;
+      evs[i++].events = revents;
 
-      poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
-      list_delete(&epn->node);
-
-      if (epn->pfd.revents != 0 && i < maxevents)
+      if ((epn->pfd.events & EPOLLONESHOT) != 0)
         {
-          evs[i].data     = epn->data;
-          evs[i++].events = epn->pfd.revents;
-          if ((epn->pfd.events & EPOLLONESHOT) != 0)
-            {
-              list_add_tail(&eph->oneshot, &epn->node);
-            }
-          else
-            {
-              list_add_tail(&eph->teardown, &epn->node);
-            }
+          poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(eph, epn);
+          list_delete(&epn->node);
+          list_add_tail(&eph->oneshot, &epn->node);
         }
-      else
+      else if ((epn->pfd.events & EPOLLET) == 0)
         {
+          poll_fdsetup(epn->pfd.fd, &epn->pfd, false);
+          epoll_unready(eph, epn);
+          list_delete(&epn->node);
           list_add_tail(&eph->teardown, &epn->node);
         }
+
+      flags = spin_lock_irqsave(&eph->rdlock);
     }
 
+  spin_unlock_irqrestore(&eph->rdlock, flags);
   nxmutex_unlock(&eph->lock);
   return i;
 }
@@ -385,7 +437,8 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
  *
  * Description:
  *   The default epoll callback function, this function do the final step of
- *   poll notification.
+ *   poll notification: move the pending events into the epoll node and
+ *   queue the node into the ready list.
  *
  * Input Parameters:
  *   fds - The fds
@@ -398,15 +451,27 @@ static int epoll_teardown(FAR epoll_head_t *eph, FAR struct epoll_event *evs,
 static void epoll_default_cb(FAR struct pollfd *fds)
 {
   FAR epoll_node_t *epn = fds->arg;
+  FAR epoll_head_t *eph = epn->eph;
+  irqstate_t flags;
   int semcount = 0;
 
-  epn->notified = true;
-  if (fds->revents != 0)
+  flags = spin_lock_irqsave(&eph->rdlock);
+  epn->revents |= fds->revents;
+  fds->revents  = 0;
+  if (!epn->ready && epn->revents != 0)
+    {
+      epn->ready = true;
+      list_add_tail(&eph->rdlist, &epn->rdnode);
+    }
+
+  spin_unlock_irqrestore(&eph->rdlock, flags);
+
+  if (epn->ready)
     {
-      nxsem_get_value(&epn->eph->sem, &semcount);
+      nxsem_get_value(&eph->sem, &semcount);
       if (semcount < 1)
         {
-          nxsem_post(&epn->eph->sem);
+          nxsem_post(&eph->sem);
         }
     }
 }
@@ -556,8 +621,9 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
         epn = container_of(list_remove_head(&eph->free), epoll_node_t, node);
         epn->eph         = eph;
         epn->data        = ev->data;
-        epn->notified    = false;
-        epn->pfd.events  = ev->events | POLLALWAYS;
+        epn->ready       = false;
+        epn->revents     = 0;
+        epn->pfd.events  = ev->events;
         epn->pfd.fd      = fd;
         epn->pfd.arg     = epn;
         epn->pfd.cb      = epoll_default_cb;
@@ -580,6 +646,7 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
             if (epn->pfd.fd == fd)
               {
                 poll_fdsetup(fd, &epn->pfd, false);
+                epoll_unready(eph, epn);
                 list_delete(&epn->node);
                 list_add_tail(&eph->free, &epn->node);
                 goto out;
@@ -614,13 +681,13 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
+                if (epn->pfd.events != ev->events)
                   {
                     poll_fdsetup(fd, &epn->pfd, false);
+                    epoll_unready(eph, epn);
 
-                    epn->notified    = false;
                     epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
+                    epn->pfd.events  = ev->events;
                     epn->pfd.fd      = fd;
                     epn->pfd.revents = 0;
 
@@ -639,11 +706,10 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                if (epn->pfd.events != (ev->events | POLLALWAYS))
+                if (epn->pfd.events != ev->events)
                   {
-                    epn->notified    = false;
                     epn->data        = ev->data;
-                    epn->pfd.events  = ev->events | POLLALWAYS;
+                    epn->pfd.events  = ev->events;
                     epn->pfd.fd      = fd;
                     epn->pfd.revents = 0;
 
@@ -665,9 +731,8 @@ int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
           {
             if (epn->pfd.fd == fd)
               {
-                epn->notified    = false;
                 epn->data        = ev->data;
-                epn->pfd.events  = ev->events | POLLALWAYS;
+                epn->pfd.events  = ev->events;
                 epn->pfd.fd      = fd;
                 epn->pfd.revents = 0;
 
@@ -731,7 +796,13 @@ retry:
 
   nxsig_procmask(SIG_SETMASK, sigmask, &oldsigmask);
 
-  if (timeout == 0)
+  if (ret > 0)
+    {
+      /* The ready list isn't empty, no need to wait */
+
+      ret = OK;
+    }
+  else if (timeout == 0)
     {
       ret = -ETIMEDOUT;
     }
@@ -804,7 +875,13 @@ retry:
 
   /* Wait the poll ready */
 
-  if (timeout == 0)
+  if (ret > 0)
+    {
+      /* The ready list isn't empty, no need to wait */
+
+      ret = OK;
+    }
+  else if (timeout == 0)
     {
       ret = -ETIMEDOUT;
     }
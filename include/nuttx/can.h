@@ -122,6 +122,8 @@
                                  /* All filters must match to trigger */
 #define CAN_RAW_TX_DEADLINE    (__SO_PROTOCOL + 6)
                                  /* Abort frame when deadline passed */
+#define CAN_RAW_FILTER_STATS   (__SO_PROTOCOL + 7)
+                                 /* Get struct can_filter_stats (RO) */
 
 /* CAN filter support (Hardware level filtering) ****************************/
 
@@ -365,6 +367,16 @@ struct can_filter
   canid_t can_mask;
 };
 
+/* struct can_filter_stats - Frames accepted and dropped by the CAN_RAW
+ * filters of a socket, returned by getsockopt(CAN_RAW_FILTER_STATS).
+ */
+
+struct can_filter_stats
+{
+  uint32_t accepted;
+  uint32_t dropped;
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
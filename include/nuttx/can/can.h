@@ -105,6 +105,10 @@
 #  define CONFIG_CAN_RXFIFOSIZE 255
 #endif
 
+#if defined(CONFIG_CAN_READER_FILTER) && !defined(CONFIG_CAN_READER_NFILTERS)
+#  define CONFIG_CAN_READER_NFILTERS 16
+#endif
+
 #if !defined(CONFIG_CAN_NPENDINGRTR)
 #  define CONFIG_CAN_NPENDINGRTR 4
 #elif CONFIG_CAN_NPENDINGRTR > 255
@@ -303,6 +307,18 @@
  *                   is returned with the errno variable set to indicate the
  *                   nature of the error.
  *   Dependencies:   None
+ *
+ * CANIOC_SET_READER_FILTER
+ *   Description:    Replace the acceptance filter list of this open file.
+ *                   Received frames are only queued to this reader if they
+ *                   match one of the filters; an empty list accepts all
+ *                   frames.  Error frames are always accepted.
+ *
+ *   Argument:       A pointer to struct canioc_rdfilter_s
+ *   returned Value: Zero (OK) is returned on success.  Otherwise -1 (ERROR)
+ *                   is returned with the errno variable set to indicate the
+ *                   nature of the error.
+ *   Dependencies:   Requires CONFIG_CAN_READER_FILTER=y
  */
 
 #define CANIOC_RTR                _CANIOC(1)
@@ -324,9 +340,10 @@
 #define CANIOC_GET_STATE          _CANIOC(17)
 #define CANIOC_SET_TRANSVSTATE    _CANIOC(18)
 #define CANIOC_GET_TRANSVSTATE    _CANIOC(19)
+#define CANIOC_SET_READER_FILTER  _CANIOC(20)
 
 #define CAN_FIRST                 0x0001         /* First common command */
-#define CAN_NCMDS                 19             /* 20 common commands   */
+#define CAN_NCMDS                 20             /* 20 common commands   */
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half CAN driver to the lower-half CAN driver via the
@@ -499,6 +516,14 @@
 #define CAN_FILTER_DUAL           1  /* Dual address match */
 #define CAN_FILTER_RANGE          2  /* Match a range of addresses */
 
+/* Reader filters: the extended ID flag is folded into the filter ID so
+ * that standard and extended frames with the same ID don't match each
+ * other.
+ */
+
+#define CAN_RDFILTER_EXTFLAG      0x80000000
+#define CAN_RDFILTER_NHASH        16 /* Number of exact ID hash buckets */
+
 /* the state is default state. Indicates that the can controller is closed */
 
 #define CAN_STATE_STOP            0
@@ -797,10 +822,31 @@ struct can_ops_s
  * The common logic will initialize all semaphores.
  */
 
+#ifdef CONFIG_CAN_READER_FILTER
+/* One compiled reader filter.  Exact ID filters are chained into the hash
+ * buckets of the reader through rm_next (1-based index, 0 ends the chain).
+ */
+
+struct can_rdmatch_s
+{
+  uint32_t             rm_id;            /* ID, with CAN_RDFILTER_EXTFLAG
+                                          * for extended IDs */
+  uint32_t             rm_mask;          /* Bits of rm_id that must match */
+  uint8_t              rm_next;          /* Next exact filter in the bucket */
+};
+#endif
+
 struct can_reader_s
 {
   struct list_node     list;
   struct can_rxfifo_s  fifo;             /* Describes receive FIFO */
+#ifdef CONFIG_CAN_READER_FILTER
+  uint8_t              rd_nfilters;      /* Number of installed filters */
+  uint8_t              rd_nexact;        /* Number of exact ID filters */
+                                         /* Exact ID hash buckets */
+  uint8_t              rd_hash[CAN_RDFILTER_NHASH];
+  struct can_rdmatch_s rd_filters[CONFIG_CAN_READER_NFILTERS];
+#endif
 };
 
 struct can_transv_s
@@ -826,6 +872,10 @@ struct can_dev_s
   FAR void            *cd_priv;          /* Used by the arch-specific logic */
   FAR struct can_transv_s *cd_transv;    /* Describes CAN transceiver */
   FAR struct pollfd   *cd_fds[CONFIG_CAN_NPOLLWAITERS];
+#ifdef CONFIG_CAN_READER_FILTER
+                                         /* Reader of each cd_fds[] slot */
+  FAR struct can_reader_s *cd_fdreaders[CONFIG_CAN_NPOLLWAITERS];
+#endif
 };
 
 /* Structures used with ioctl calls */
@@ -915,6 +965,28 @@ struct canioc_stdfilter_s
   uint8_t               sf_prio;         /* See CAN_MSGPRIO_* definitions */
 };
 
+#ifdef CONFIG_CAN_READER_FILTER
+/* CANIOC_SET_READER_FILTER: */
+
+struct can_rdfilter_s
+{
+  uint32_t              rf_id;           /* 11-bit or 29-bit message ID */
+  uint32_t              rf_mask;         /* Bits of the ID that must match,
+                                          * all ID bits set for an exact
+                                          * match */
+#ifdef CONFIG_CAN_EXTID
+  bool                  rf_extid;        /* Match extended ID frames */
+#endif
+};
+
+struct canioc_rdfilter_s
+{
+  FAR const struct can_rdfilter_s *rf_filters; /* The filter list */
+  uint8_t               rf_nfilters;     /* Number of filters, zero accepts
+                                          * all frames */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
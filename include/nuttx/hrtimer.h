@@ -51,6 +51,7 @@ struct hrtimer_ops_s {
 struct hrtimer_s {
 	hrtimer_tick_t expiration_time;
 	struct hrtimer_queue_s *queue;
+	int index; /* Slot in queue->heap[], -1 when not queued */
 	hrtimer_callback_t callback;
 	void *arg;
 };
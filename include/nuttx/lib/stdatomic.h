@@ -161,6 +161,8 @@
 #define atomic_fetch_sub(obj, val) atomic_fetch_sub_n(obj, val, __ATOMIC_RELAXED)
 #define atomic_fetch_sub_explicit(obj, val, type) atomic_fetch_sub_n(obj, val, type)
 
+#define atomic_thread_fence(order) __sync_synchronize()
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -270,5 +272,6 @@ uint32_t __atomic_fetch_xor_4(FAR volatile void *ptr, uint32_t value,
                               int memorder);
 uint64_t __atomic_fetch_xor_8(FAR volatile void *ptr, uint64_t value,
                               int memorder);
+void __sync_synchronize(void);
 
 #endif /* __INCLUDE_NUTTX_LIB_STDATOMIC_H */
@@ -78,10 +78,24 @@
 #  define CONFIG_IOB_ALIGNMENT      1
 #endif
 
+/* Optional size classes of pre-allocated I/O buffers (see iob_alloc_fit()) */
+
+#if !defined(CONFIG_IOB_CLASS1_BUFSIZE)
+#  define CONFIG_IOB_CLASS1_BUFSIZE 0
+#endif
+
+#if !defined(CONFIG_IOB_CLASS2_BUFSIZE)
+#  define CONFIG_IOB_CLASS2_BUFSIZE 0
+#endif
+
+#if defined(CONFIG_IOB_ALLOC) && \
+    (CONFIG_IOB_CLASS1_BUFSIZE > 0 || CONFIG_IOB_CLASS2_BUFSIZE > 0)
+#  define IOB_HAVE_CLASSES 1
+#endif
+
 /* IOB helpers */
 
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -96,6 +110,8 @@
 #  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
 #endif
 
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -221,6 +237,55 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_fit
+ *
+ * Description:
+ *   Allocate the pre-allocated I/O buffer whose payload best fits 'size'
+ *   bytes: the smallest one holding 'size' bytes, or the largest one if
+ *   none does.  Buffers of the size classes configured with
+ *   CONFIG_IOB_CLASSn_BUFSIZE are taken without waiting, and the call
+ *   falls back to iob_alloc() when no better fitting buffer is free.  The
+ *   buffer may have any payload size, use IOB_BUFSIZE() to get it.
+ *
+ * Input Parameters:
+ *   size      - The number of bytes the caller wants to store.
+ *   throttled - An indication of the IOB allocation is "throttled".  The
+ *               size classes are not covered by CONFIG_IOB_THROTTLE, so
+ *               throttled allocations only take CONFIG_IOB_BUFSIZE
+ *               buffers, as iob_alloc() does.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_tryalloc_fit
+ *
+ * Description:
+ *   Like iob_alloc_fit(), but never waits for a buffer to become free.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_tryalloc_fit_large
+ *
+ * Description:
+ *   Like iob_tryalloc_fit(), but never return a buffer smaller than
+ *   CONFIG_IOB_BUFSIZE bytes, for the callers (e.g. network drivers doing
+ *   DMA into a single buffer) which rely on the payload size of the
+ *   buffers returned by iob_tryalloc().
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+FAR struct iob_s *iob_alloc_fit(unsigned int size, bool throttled);
+FAR struct iob_s *iob_tryalloc_fit(unsigned int size, bool throttled);
+FAR struct iob_s *iob_tryalloc_fit_large(unsigned int size, bool throttled);
+#else
+#  define iob_alloc_fit(size, throttled)          iob_alloc(throttled)
+#  define iob_tryalloc_fit(size, throttled)       iob_tryalloc(throttled)
+#  define iob_tryalloc_fit_large(size, throttled) iob_tryalloc(throttled)
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
 /****************************************************************************
  * Name: iob_alloc_dynamic
@@ -66,6 +66,8 @@ typedef CODE void (*mempool_free_t)(FAR struct mempool_s *pool,
                                     FAR void *addr);
 typedef CODE void (*mempool_check_t)(FAR struct mempool_s *pool,
                                      FAR void *addr);
+typedef CODE void (*mempool_ctor_t)(FAR struct mempool_s *pool,
+                                    FAR void *blk);
 
 typedef CODE FAR void *(*mempool_multiple_alloc_t)(FAR void *arg,
                                                    size_t alignment,
@@ -93,6 +95,21 @@ struct mempool_procfs_entry_s
 };
 #endif
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+/* This structure describes the per-CPU cache of free blocks that sits in
+ * front of the shared queue.  It is only touched by the owning CPU with
+ * local interrupts disabled, so the common path needs no lock.
+ */
+
+struct mempool_magazine_s
+{
+  size_t         count;  /* The number of cached blocks */
+  unsigned long  nhit;   /* The number of requests served by the magazine */
+  unsigned long  nmiss;  /* The number of requests that took the pool lock */
+  FAR sq_entry_t *blocks[CONFIG_MM_MEMPOOL_MAGAZINE];
+};
+#endif
+
 /* This structure describes memory buffer pool */
 
 struct mempool_s
@@ -106,6 +123,7 @@ struct mempool_s
   mempool_alloc_t alloc;    /* The alloc function for mempool */
   mempool_free_t  free;     /* The free function for mempool */
   mempool_check_t check;    /* The check function for mempool */
+  mempool_ctor_t  ctor;     /* The optional constructor of new blocks */
 
   /* Private data for memory pool */
 
@@ -116,6 +134,9 @@ struct mempool_s
   size_t     nalloc;  /* The number of used block in mempool */
   spinlock_t lock;    /* The protect lock to mempool */
   sem_t      waitsem; /* The semaphore of waiter get free block */
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  struct mempool_magazine_s magazine[CONFIG_SMP_NCPUS]; /* Per-CPU caches */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
   struct mempool_procfs_entry_s procfs; /* The entry of procfs */
 #endif
@@ -143,6 +164,10 @@ struct mempoolinfo_s
   unsigned long aordblks; /* This is the number of used blocks */
   unsigned long sizeblks; /* This is the size of a mempool blocks */
   unsigned long nwaiter;  /* This is the number of waiter for mempool */
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  unsigned long nhit;     /* This is the number of per-CPU magazine hits */
+  unsigned long nmiss;    /* This is the number of per-CPU magazine misses */
+#endif
 };
 
 /****************************************************************************
@@ -177,6 +202,39 @@ extern "C"
 
 int mempool_init(FAR struct mempool_s *pool, FAR const char *name);
 
+/****************************************************************************
+ * Name: mempool_create
+ *
+ * Description:
+ *   Create a memory pool of fixed-size kernel objects backed by the kernel
+ *   heap, as a replacement for the hand-rolled free lists of subsystems.
+ *
+ *   If ctor isn't NULL, it is called once for every block when the block
+ *   is added to the pool, and not again when the block is reused: objects
+ *   must be released in their constructed state.  The first pointer-sized
+ *   word of a block is used by the pool while the block is free, so the
+ *   constructor must not rely on it (it is typically the list node of the
+ *   object).
+ *
+ * Input Parameters:
+ *   name      - The name of memory pool.
+ *   blocksize - The size of one object.
+ *   ninitial  - The number of objects allocated at creation.
+ *   nexpand   - The number of objects allocated each time the pool runs
+ *               out of blocks, 0 to never expand.
+ *   ctor      - The constructor of new objects, or NULL.
+ *   priv      - The user's private data, available as pool->priv.
+ *
+ * Returned Value:
+ *   The memory pool on success; NULL on any failure.
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+FAR struct mempool_s *mempool_create(FAR const char *name, size_t blocksize,
+                                     size_t ninitial, size_t nexpand,
+                                     mempool_ctor_t ctor, FAR void *priv);
+#endif
+
 /****************************************************************************
  * Name: mempool_allocate
  *
@@ -259,6 +317,23 @@ void mempool_memdump(FAR struct mempool_s *pool,
 
 int mempool_deinit(FAR struct mempool_s *pool);
 
+/****************************************************************************
+ * Name: mempool_destroy
+ *
+ * Description:
+ *   Destroy a memory pool created by mempool_create().
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   OK on success; -EBUSY if some objects are still allocated.
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+int mempool_destroy(FAR struct mempool_s *pool);
+#endif
+
 /****************************************************************************
  * Name: mempool_info_task
  *
@@ -141,7 +141,7 @@
 #if CONFIG_MM_BACKTRACE >= 0
 #  define MM_DUMP_ALLOC(dump, node) \
     ((node) != NULL && (dump)->pid == PID_MM_ALLOC && \
-     (node)->pid != PID_MM_MEMPOOL)
+     (node)->pid != PID_MM_MEMPOOL && (node)->pid != PID_MM_TCACHE)
 #  define MM_DUMP_SEQNO(dump, node) \
     ((node)->seqno >= (dump)->seqmin && (node)->seqno <= (dump)->seqmax)
 #  define MM_DUMP_ASSIGN(dump, node) \
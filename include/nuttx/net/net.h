@@ -181,6 +181,9 @@ struct sock_intf_s
                     FAR struct file *infile, FAR off_t *offset,
                     size_t count);
 #endif
+  CODE int        (*si_sendmmsg)(FAR struct socket *psock,
+                    FAR struct mmsghdr *msgvec, unsigned int vlen,
+                    int flags);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -928,6 +931,56 @@ ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                       int flags);
 
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends a burst of messages to a socket.  It is the
+ *   internal OS interface of sendmmsg(), like psock_sendmsg() is that of
+ *   sendmsg().
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to send, msg_len receives the bytes sent
+ *   vlen      The number of entries in msgvec
+ *   flags     Send flags
+ *
+ * Returned Value:
+ *   The number of messages sent, which may be less than vlen.  A negated
+ *   errno value is returned only if not even the first message was sent.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives a burst of messages from a socket.  It is the
+ *   internal OS interface of recvmmsg(), like psock_recvmsg() is that of
+ *   recvmsg().
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    Buffers to receive data, msg_len receives the bytes received
+ *   vlen      The number of entries in msgvec
+ *   flags     Receive flags, MSG_WAITFORONE turns on MSG_DONTWAIT after the
+ *             first message
+ *   timeout   Optional limit on the time spent receiving, checked after
+ *             each message
+ *
+ * Returned Value:
+ *   The number of messages received.  A negated errno value is returned
+ *   only if not even the first message was received.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout);
+
 /****************************************************************************
  * Name: psock_send
  *
@@ -293,8 +293,11 @@ struct netdev_ifaddr6_s
 #ifdef CONFIG_NETDEV_RSS
 struct netdev_rss_s
 {
-  int      cpu;  /* CPU ID */
-  uint32_t hash; /* Hash value with packet */
+  int      cpu;   /* CPU ID */
+  uint32_t hash;  /* Hash value with packet */
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  int      queue; /* RX queue serviced on the CPU, -1 if none */
+#endif
 };
 #endif // CONFIG_NETDEV_RSS
 
@@ -339,6 +342,17 @@ struct net_driver_s
 
   uint16_t d_pktsize;           /* Maximum packet size */
 
+#ifdef CONFIG_NETDEV_GSO
+  /* Generic segmentation offload.  d_gso_maxsize is the largest TCP payload
+   * the driver accepts in one packet (zero: MSS-sized packets only).
+   * d_gso_size is set by TCP when the packet in d_iob carries more than one
+   * MSS and must be split into d_gso_size-sized segments by the driver.
+   */
+
+  uint16_t d_gso_maxsize;       /* Maximum GSO payload size */
+  uint16_t d_gso_size;          /* Segment size of the pending packet */
+#endif
+
   /* Link layer address */
 
 #if defined(CONFIG_NET_ETHERNET) || defined(CONFIG_NET_6LOWPAN) || \
@@ -1347,4 +1361,30 @@ int netdev_ipv6_foreach(FAR struct net_driver_s *dev,
 void netdev_statistics_log(FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: netdev_rss_hash
+ *
+ * Description:
+ *   Compute the flow hash passed to drivers with SIOCNOTIFYRECVCPU, so
+ *   that received packets can be matched against it.  Addresses and ports
+ *   are in network order; src is the local end of the flow.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_addr - The source address
+ *   src_port - The source port
+ *   dst_addr - The destination address
+ *   dst_port - The destination port
+ *
+ * Returned Value:
+ *   The hash value
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RSS
+uint32_t netdev_rss_hash(uint8_t domain,
+                         FAR const void *src_addr, uint16_t src_port,
+                         FAR const void *dst_addr, uint16_t dst_port);
+#endif
+
 #endif /* __INCLUDE_NUTTX_NET_NETDEV_H */
@@ -48,6 +48,14 @@
 #  define CONFIG_NETDEV_WORK_THREAD_POLLING_PERIOD 0
 #endif
 
+#ifndef CONFIG_NETDEV_MAX_QUEUES
+#  define CONFIG_NETDEV_MAX_QUEUES 1
+#endif
+
+#ifndef CONFIG_NETDEV_RSS_FLOWS
+#  define CONFIG_NETDEV_RSS_FLOWS 0
+#endif
+
 /* Layout for net packet:
  *
  * | <-------------- NETPKT_BUFLEN ---------------> |
@@ -119,6 +127,15 @@ struct netdev_lowerhalf_s
 
   atomic_int quota[NETPKT_TYPENUM];
 
+  /* Number of RX/TX queue pairs, set before registering a multi-queue
+   * device (which then provides receiveq/transmitq). 0 or 1 means a single
+   * queue served through receive/transmit.
+   */
+
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  uint8_t nqueues;
+#endif
+
   /* The structure used by net stack.
    * Note: Do not change its fields unless you know what you are doing.
    *
@@ -158,6 +175,18 @@ struct netdev_ops_s
 
   CODE FAR netpkt_t *(*receive)(FAR struct netdev_lowerhalf_s *dev);
 
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+  /* transmitq/receiveq - Same as transmit/receive, on one queue of a
+   *   multi-queue device.  They are called with the network locked, but
+   *   different queues are drained from different CPUs.
+   */
+
+  CODE int (*transmitq)(FAR struct netdev_lowerhalf_s *dev, int queue,
+                        FAR netpkt_t *pkt);
+  CODE FAR netpkt_t *(*receiveq)(FAR struct netdev_lowerhalf_s *dev,
+                                 int queue);
+#endif
+
 #ifdef CONFIG_NET_MCASTGROUP
   CODE int (*addmac)(FAR struct netdev_lowerhalf_s *dev,
                      FAR const uint8_t *mac);
@@ -308,6 +337,43 @@ void netdev_lower_rxready(FAR struct netdev_lowerhalf_s *dev);
 
 void netdev_lower_txdone(FAR struct netdev_lowerhalf_s *dev);
 
+/****************************************************************************
+ * Name: netdev_lower_rxready_queue
+ *
+ * Description:
+ *   Notifies the networking layer about an RX packet is ready to read on
+ *   one queue of a multi-queue device.  The queue is drained by the worker
+ *   thread of the CPU it is bound to.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The RX queue index
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_lower_txdone_queue
+ *
+ * Description:
+ *   Notifies the networking layer about a TX packet is sent on one queue of
+ *   a multi-queue device.
+ *
+ * Input Parameters:
+ *   dev   - The lower half device driver structure
+ *   queue - The TX queue index
+ *
+ ****************************************************************************/
+
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+void netdev_lower_rxready_queue(FAR struct netdev_lowerhalf_s *dev,
+                                int queue);
+void netdev_lower_txdone_queue(FAR struct netdev_lowerhalf_s *dev,
+                               int queue);
+#else
+#  define netdev_lower_rxready_queue(dev, queue) netdev_lower_rxready(dev)
+#  define netdev_lower_txdone_queue(dev, queue)  netdev_lower_txdone(dev)
+#endif
+
 /****************************************************************************
  * Name: netdev_lower_quota_load
  *
@@ -849,6 +849,16 @@ typedef CODE void (*nxsched_handshake_t)(FAR struct tcb_s *tcb,
 typedef CODE int (*nxsched_smp_call_t)(FAR void *arg);
 #endif
 
+/* These are the callback types used by nxsched_bmp_call() and the BMP
+ * mailbox channels.
+ */
+
+#ifdef CONFIG_BMP_CALL
+typedef CODE int (*nxsched_bmp_call_t)(FAR void *arg);
+typedef CODE void (*nxsched_bmp_mbox_t)(int cpu, FAR void *msg,
+                                        FAR void *arg);
+#endif
+
 #endif /* __ASSEMBLY__ */
 
 /****************************************************************************
@@ -1775,6 +1785,89 @@ int nxsched_smp_call(cpu_set_t cpuset, nxsched_smp_call_t func,
                      FAR void *arg, bool wait);
 #endif
 
+#ifdef CONFIG_BMP_CALL
+/****************************************************************************
+ * Name: nxsched_bmp_call_handler
+ *
+ * Description:
+ *   BMP function call doorbell handler
+ *
+ * Input Parameters:
+ *   irq     - Interrupt id
+ *   context - Regs context before irq
+ *   arg     - Interrupt arg
+ *
+ * Returned Value:
+ *   Result
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_call_handler(int irq, FAR void *context,
+                             FAR void *arg);
+
+/****************************************************************************
+ * Name: nxsched_bmp_call
+ *
+ * Description:
+ *   Call function on another BMP processor.  The function runs in the
+ *   interrupt context of the target processor; func and arg must be
+ *   reachable from there (i.e. arg must live in shared memory).
+ *
+ * Input Parameters:
+ *   cpu  - Target cpu id
+ *   func - Function
+ *   arg  - Function args
+ *   wait - Wait for the function to return or just post the call
+ *
+ * Returned Value:
+ *   The function's return value if wait is true, otherwise OK.  A negated
+ *   errno value is returned if the call could not be queued.
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_call(int cpu, nxsched_bmp_call_t func, FAR void *arg,
+                     bool wait);
+
+/****************************************************************************
+ * Name: nxsched_bmp_mbox_bind
+ *
+ * Description:
+ *   Bind a handler to a mailbox channel of this processor.  The handler is
+ *   called in interrupt context for each message sent to the channel.
+ *
+ * Input Parameters:
+ *   chan    - Mailbox channel, 0 .. CONFIG_BMP_CALL_NMBOX - 1
+ *   handler - Message handler, NULL to unbind
+ *   arg     - Handler private data
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_mbox_bind(int chan, nxsched_bmp_mbox_t handler,
+                          FAR void *arg);
+
+/****************************************************************************
+ * Name: nxsched_bmp_mbox_send
+ *
+ * Description:
+ *   Send a message to a mailbox channel of another processor without
+ *   waiting for it to be handled.
+ *
+ * Input Parameters:
+ *   cpu  - Target cpu id
+ *   chan - Mailbox channel on the target cpu
+ *   msg  - Message, must live in shared memory
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_mbox_send(int cpu, int chan, FAR void *msg);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -34,6 +34,12 @@
 
 #include <nuttx/clock.h>
 
+#ifdef CONFIG_SEM_FAST_PATH
+#  include <limits.h>
+#  include <stdbool.h>
+#  include <nuttx/atomic.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -723,6 +729,107 @@ int nxsem_getprioceiling(FAR const sem_t *sem, FAR int *prioceiling);
 int nxsem_setprioceiling(FAR sem_t *sem, int prioceiling,
                          FAR int *old_ceiling);
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_FAST_PATH
+
+/****************************************************************************
+ * Name: nxsem_fast_capable
+ *
+ * Description:
+ *   Return true if the semaphore may be taken and released without the
+ *   kernel slow path, i.e. it does not need holder tracking for priority
+ *   inheritance or a priority ceiling.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_fast_capable(FAR sem_t *sem)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((sem->flags & SEM_PRIO_MASK) == SEM_PRIO_INHERIT)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_PRIORITY_PROTECT
+  if ((sem->flags & SEM_PRIO_MASK) == SEM_PRIO_PROTECT)
+    {
+      return false;
+    }
+#endif
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsem_fast_trywait
+ *
+ * Description:
+ *   Try to take one count of an uncontended semaphore with a single
+ *   compare-and-swap.  The count is only ever moved from a positive value
+ *   to the next lower one, so the waiter bookkeeping of the slow path
+ *   (negative counts) is never touched.  A successful exchange has
+ *   acquire semantics, pairing with the release in nxsem_fast_post().
+ *
+ * Returned Value:
+ *   true if a count was taken; false if the count was not positive and
+ *   the caller must fall back to the slow path.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_fast_trywait(FAR sem_t *sem)
+{
+  short count = atomic_load((FAR atomic_short *)&sem->semcount);
+
+  while (count > 0)
+    {
+      if (atomic_compare_exchange_weak_explicit(
+            (FAR atomic_short *)&sem->semcount, &count, count - 1,
+            memory_order_acquire, memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nxsem_fast_post
+ *
+ * Description:
+ *   Release one count of a semaphore that nobody is waiting for with a
+ *   single compare-and-swap.
+ *
+ * Returned Value:
+ *   true if the count was released; false if there are waiters to wake
+ *   up (or the count would overflow) and the caller must fall back to the
+ *   slow path.
+ *
+ ****************************************************************************/
+
+static inline bool nxsem_fast_post(FAR sem_t *sem)
+{
+  short count = atomic_load((FAR atomic_short *)&sem->semcount);
+
+  while (count >= 0 && count < SEM_VALUE_MAX)
+    {
+      if (atomic_compare_exchange_weak_explicit(
+            (FAR atomic_short *)&sem->semcount, &count, count + 1,
+            memory_order_release, memory_order_relaxed))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+#endif /* CONFIG_SEM_FAST_PATH */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
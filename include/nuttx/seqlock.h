@@ -0,0 +1,128 @@
+/****************************************************************************
+ * include/nuttx/seqlock.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SEQLOCK_H
+#define __INCLUDE_NUTTX_SEQLOCK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+
+#include <nuttx/atomic.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SEQCOUNT_INITIALIZER {0}
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A sequence counter lets readers copy data without taking the lock that
+ * serializes its writers.  The count is odd while a write is in progress;
+ * a reader that sees an odd count, or a count that changed while it was
+ * reading, must discard what it read.
+ *
+ * Writers must already be serialized by some other lock.  Readers do not
+ * spin: a reader that runs while a (possibly preempted, lower priority)
+ * writer is active would never make progress, so a failed read should be
+ * repeated while holding the writers' lock instead.
+ */
+
+typedef struct seqcount_s
+{
+  atomic_uint sequence;
+} seqcount_t;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: seqcount_init
+ ****************************************************************************/
+
+static inline void seqcount_init(FAR seqcount_t *s)
+{
+  atomic_store_explicit(&s->sequence, 0, memory_order_relaxed);
+}
+
+/****************************************************************************
+ * Name: read_seqbegin
+ *
+ * Description:
+ *   Start a read section and return the count to pass to read_seqretry().
+ *
+ ****************************************************************************/
+
+static inline unsigned int read_seqbegin(FAR seqcount_t *s)
+{
+  return atomic_load_explicit(&s->sequence, memory_order_acquire);
+}
+
+/****************************************************************************
+ * Name: read_seqretry
+ *
+ * Description:
+ *   Return true if the data read since read_seqbegin() may be inconsistent.
+ *
+ ****************************************************************************/
+
+static inline bool read_seqretry(FAR seqcount_t *s, unsigned int start)
+{
+  atomic_thread_fence(memory_order_acquire);
+  return (start & 1) != 0 ||
+         atomic_load_explicit(&s->sequence, memory_order_relaxed) != start;
+}
+
+/****************************************************************************
+ * Name: write_seqbegin and write_seqend
+ *
+ * Description:
+ *   Bracket a modification of the data protected by the counter.
+ *
+ ****************************************************************************/
+
+static inline void write_seqbegin(FAR seqcount_t *s)
+{
+  unsigned int seq = atomic_load_explicit(&s->sequence,
+                                          memory_order_relaxed);
+
+  atomic_store_explicit(&s->sequence, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+static inline void write_seqend(FAR seqcount_t *s)
+{
+  unsigned int seq = atomic_load_explicit(&s->sequence,
+                                          memory_order_relaxed);
+
+  atomic_store_explicit(&s->sequence, seq + 1, memory_order_release);
+}
+
+#endif /* __INCLUDE_NUTTX_SEQLOCK_H */
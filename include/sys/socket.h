@@ -136,6 +136,7 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_WAITFORONE   0x010000 /* recvmmsg(): only wait for the 1st */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
@@ -370,6 +371,16 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* For recvmmsg() and sendmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* Message header */
+  unsigned int msg_len;         /* Number of bytes transmitted */
+};
+
+struct timespec;                /* Forward reference */
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -457,6 +468,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
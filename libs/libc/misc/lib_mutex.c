@@ -246,6 +246,18 @@ int nxmutex_lock(FAR mutex_t *mutex)
   int ret;
 
   DEBUGASSERT(!nxmutex_is_hold(mutex));
+
+#ifdef CONFIG_SEM_FAST_PATH
+  /* Take an uncontended mutex without entering the kernel */
+
+  if (nxsem_fast_capable(&mutex->sem) && nxsem_fast_trywait(&mutex->sem))
+    {
+      mutex->holder = _SCHED_GETTID();
+      nxmutex_add_backtrace(mutex);
+      return OK;
+    }
+#endif
+
   for (; ; )
     {
       /* Take the semaphore (perhaps waiting) */
@@ -291,7 +303,17 @@ int nxmutex_trylock(FAR mutex_t *mutex)
 {
   int ret;
 
-  ret = nxsem_trywait(&mutex->sem);
+#ifdef CONFIG_SEM_FAST_PATH
+  if (nxsem_fast_capable(&mutex->sem))
+    {
+      ret = nxsem_fast_trywait(&mutex->sem) ? OK : -EAGAIN;
+    }
+  else
+#endif
+    {
+      ret = nxsem_trywait(&mutex->sem);
+    }
+
   if (ret < 0)
     {
       return ret;
@@ -429,6 +451,15 @@ int nxmutex_unlock(FAR mutex_t *mutex)
 
   mutex->holder = NXMUTEX_NO_HOLDER;
 
+#ifdef CONFIG_SEM_FAST_PATH
+  /* Release the mutex without entering the kernel if nobody waits */
+
+  if (nxsem_fast_capable(&mutex->sem) && nxsem_fast_post(&mutex->sem))
+    {
+      return OK;
+    }
+#endif
+
   ret = nxsem_post(&mutex->sem);
   if (ret < 0)
     {
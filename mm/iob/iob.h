@@ -123,6 +123,35 @@ FAR struct iob_qentry_s *iob_tryalloc_qentry(void);
 
 FAR struct iob_qentry_s *iob_free_qentry(FAR struct iob_qentry_s *iobq);
 
+/****************************************************************************
+ * Name: iob_class_initialize
+ *
+ * Description:
+ *   Set up the pre-allocated I/O buffers of the configured size classes.
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+void iob_class_initialize(void);
+#endif
+
+/****************************************************************************
+ * Name: iob_class_free
+ *
+ * Description:
+ *   Return the I/O buffer to the free list of its size class.  This
+ *   function is intended only for internal use by iob_free().
+ *
+ * Returned Value:
+ *   True if the I/O buffer belongs to a size class and has been freed;
+ *   false otherwise.
+ *
+ ****************************************************************************/
+
+#ifdef IOB_HAVE_CLASSES
+bool iob_class_free(FAR struct iob_s *iob);
+#endif
+
 /****************************************************************************
  * Name: iob_notifier_signal
  *
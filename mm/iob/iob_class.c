@@ -0,0 +1,392 @@
+/****************************************************************************
+ * mm/iob/iob_class.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/param.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef IOB_HAVE_CLASSES
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_IOB_CLASS1_NBUFFERS
+#  define CONFIG_IOB_CLASS1_NBUFFERS 0
+#endif
+
+#ifndef CONFIG_IOB_CLASS2_NBUFFERS
+#  define CONFIG_IOB_CLASS2_NBUFFERS 0
+#endif
+
+/* Each buffer of a size class is an iob_s immediately followed by its
+ * payload, both starting on the CONFIG_IOB_ALIGNMENT boundary.
+ */
+
+#define IOB_CLASS_ALIGNMENT    MAX(CONFIG_IOB_ALIGNMENT, sizeof(uintptr_t))
+#define IOB_CLASS_HDRSIZE      ROUNDUP(sizeof(struct iob_s), \
+                                       IOB_CLASS_ALIGNMENT)
+#define IOB_CLASS_ALIGN_SIZE(n) \
+  ROUNDUP(IOB_CLASS_HDRSIZE + (n), IOB_CLASS_ALIGNMENT)
+#define IOB_CLASS_BUFFER_SIZE(n, nbuffers) \
+  (IOB_CLASS_ALIGN_SIZE(n) * (nbuffers) + IOB_CLASS_ALIGNMENT - 1)
+
+/* The size classes, plus the CONFIG_IOB_BUFSIZE buffers of iob_alloc() */
+
+#define IOB_NCLASSES           ((CONFIG_IOB_CLASS1_BUFSIZE > 0) + \
+                                (CONFIG_IOB_CLASS2_BUFSIZE > 0) + 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct iob_class_s
+{
+  FAR uint8_t *base;          /* First buffer, NULL for iob_alloc() buffers */
+  FAR uint8_t *end;           /* End of the last buffer */
+  FAR struct iob_s *freelist; /* Free buffers of this size class */
+  uint16_t bufsize;           /* Payload size of each buffer */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if CONFIG_IOB_CLASS1_BUFSIZE > 0
+#  ifdef IOB_SECTION
+static uint8_t g_iob_class1_buffer[
+  IOB_CLASS_BUFFER_SIZE(CONFIG_IOB_CLASS1_BUFSIZE,
+                        CONFIG_IOB_CLASS1_NBUFFERS)] locate_data(IOB_SECTION);
+#  else
+static uint8_t g_iob_class1_buffer[
+  IOB_CLASS_BUFFER_SIZE(CONFIG_IOB_CLASS1_BUFSIZE,
+                        CONFIG_IOB_CLASS1_NBUFFERS)];
+#  endif
+#endif
+
+#if CONFIG_IOB_CLASS2_BUFSIZE > 0
+#  ifdef IOB_SECTION
+static uint8_t g_iob_class2_buffer[
+  IOB_CLASS_BUFFER_SIZE(CONFIG_IOB_CLASS2_BUFSIZE,
+                        CONFIG_IOB_CLASS2_NBUFFERS)] locate_data(IOB_SECTION);
+#  else
+static uint8_t g_iob_class2_buffer[
+  IOB_CLASS_BUFFER_SIZE(CONFIG_IOB_CLASS2_BUFSIZE,
+                        CONFIG_IOB_CLASS2_NBUFFERS)];
+#  endif
+#endif
+
+/* All the size classes, sorted by increasing payload size */
+
+static struct iob_class_s g_iob_class[IOB_NCLASSES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_class_add
+ *
+ * Description:
+ *   Carve a raw buffer into I/O buffers and insert their size class into
+ *   the sorted class table.
+ *
+ ****************************************************************************/
+
+static void iob_class_add(FAR uint8_t *buffer, uint16_t bufsize,
+                          int nbuffers, FAR int *nclasses)
+{
+  FAR struct iob_class_s *cls;
+  uintptr_t buf;
+  int i;
+
+  /* Keep the table sorted by increasing payload size */
+
+  for (i = *nclasses; i > 0 && g_iob_class[i - 1].bufsize > bufsize; i--)
+    {
+      g_iob_class[i] = g_iob_class[i - 1];
+    }
+
+  cls           = &g_iob_class[i];
+  cls->base     = NULL;
+  cls->end      = NULL;
+  cls->freelist = NULL;
+  cls->bufsize  = bufsize;
+  (*nclasses)++;
+
+  if (buffer == NULL)
+    {
+      return;
+    }
+
+  buf       = ROUNDUP((uintptr_t)buffer, IOB_CLASS_ALIGNMENT);
+  cls->base = (FAR uint8_t *)buf;
+  cls->end  = cls->base + nbuffers * IOB_CLASS_ALIGN_SIZE(bufsize);
+
+  for (i = 0; i < nbuffers; i++)
+    {
+      FAR struct iob_s *iob = (FAR struct iob_s *)
+        (buf + i * IOB_CLASS_ALIGN_SIZE(bufsize));
+
+      iob->io_flink   = cls->freelist;
+      iob->io_bufsize = bufsize;
+      iob->io_free    = NULL;
+      iob->io_data    = (FAR uint8_t *)iob + IOB_CLASS_HDRSIZE;
+      cls->freelist   = iob;
+    }
+}
+
+/****************************************************************************
+ * Name: iob_class_tryalloc
+ *
+ * Description:
+ *   Take a free I/O buffer of the given size class without waiting.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_class_tryalloc(FAR struct iob_class_s *cls,
+                                            bool throttled)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  if (cls->base == NULL)
+    {
+      return iob_tryalloc(throttled);
+    }
+
+  flags = enter_critical_section();
+
+  iob = cls->freelist;
+  if (iob != NULL)
+    {
+      cls->freelist = iob->io_flink;
+    }
+
+  leave_critical_section(flags);
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_class_tryfit
+ *
+ * Description:
+ *   Try to allocate the I/O buffer whose payload best fits 'size' bytes,
+ *   ignoring the size classes smaller than 'minsize' bytes.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_class_tryfit(unsigned int size,
+                                          unsigned int minsize,
+                                          bool throttled)
+{
+  FAR struct iob_s *iob;
+  int first;
+  int i;
+
+  /* The size classes are not covered by CONFIG_IOB_THROTTLE: leave them to
+   * the unthrottled allocations, e.g. the network drivers.
+   */
+
+  if (throttled)
+    {
+      return iob_tryalloc(true);
+    }
+
+  /* Find the smallest size class holding 'size' bytes */
+
+  size = MAX(size, minsize);
+  for (first = 0; first < IOB_NCLASSES; first++)
+    {
+      if (g_iob_class[first].bufsize >= size)
+        {
+          break;
+        }
+    }
+
+  /* Try that class and then the larger ones.  If none of them has a free
+   * buffer, the data will need a chain anyway, so the largest of the
+   * remaining classes makes it the shortest.
+   */
+
+  for (i = first; i < IOB_NCLASSES; i++)
+    {
+      iob = iob_class_tryalloc(&g_iob_class[i], throttled);
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+
+  for (i = first - 1; i >= 0 && g_iob_class[i].bufsize >= minsize; i--)
+    {
+      iob = iob_class_tryalloc(&g_iob_class[i], throttled);
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_class_initialize
+ *
+ * Description:
+ *   Set up the pre-allocated I/O buffers of the configured size classes.
+ *
+ ****************************************************************************/
+
+void iob_class_initialize(void)
+{
+  int nclasses = 0;
+
+  iob_class_add(NULL, CONFIG_IOB_BUFSIZE, 0, &nclasses);
+#if CONFIG_IOB_CLASS1_BUFSIZE > 0
+  iob_class_add(g_iob_class1_buffer, CONFIG_IOB_CLASS1_BUFSIZE,
+                CONFIG_IOB_CLASS1_NBUFFERS, &nclasses);
+#endif
+#if CONFIG_IOB_CLASS2_BUFSIZE > 0
+  iob_class_add(g_iob_class2_buffer, CONFIG_IOB_CLASS2_BUFSIZE,
+                CONFIG_IOB_CLASS2_NBUFFERS, &nclasses);
+#endif
+
+  DEBUGASSERT(nclasses == IOB_NCLASSES);
+}
+
+/****************************************************************************
+ * Name: iob_class_free
+ *
+ * Description:
+ *   Return the I/O buffer to the free list of its size class.  This
+ *   function is intended only for internal use by iob_free().
+ *
+ * Returned Value:
+ *   True if the I/O buffer belongs to a size class and has been freed;
+ *   false otherwise.
+ *
+ ****************************************************************************/
+
+bool iob_class_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_class_s *cls;
+  irqstate_t flags;
+  int i;
+
+  for (i = 0; i < IOB_NCLASSES; i++)
+    {
+      cls = &g_iob_class[i];
+      if (cls->base != NULL && (FAR uint8_t *)iob >= cls->base &&
+          (FAR uint8_t *)iob < cls->end)
+        {
+          DEBUGASSERT(iob->io_bufsize == cls->bufsize);
+
+          flags         = enter_critical_section();
+          iob->io_flink = cls->freelist;
+          cls->freelist = iob;
+          leave_critical_section(flags);
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_fit
+ *
+ * Description:
+ *   Try to allocate the I/O buffer whose payload best fits 'size' bytes,
+ *   without waiting for a buffer to become free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_fit(unsigned int size, bool throttled)
+{
+  return iob_class_tryfit(size, 0, throttled);
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_fit_large
+ *
+ * Description:
+ *   Like iob_tryalloc_fit(), but never return a buffer smaller than
+ *   CONFIG_IOB_BUFSIZE bytes.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_fit_large(unsigned int size, bool throttled)
+{
+  return iob_class_tryfit(size, CONFIG_IOB_BUFSIZE, throttled);
+}
+
+/****************************************************************************
+ * Name: iob_alloc_fit
+ *
+ * Description:
+ *   Allocate the I/O buffer whose payload best fits 'size' bytes, waiting
+ *   for a CONFIG_IOB_BUFSIZE buffer if none is free.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_fit(unsigned int size, bool throttled)
+{
+  FAR struct iob_s *iob;
+
+  iob = iob_tryalloc_fit(size, throttled);
+  if (iob == NULL)
+    {
+      iob = iob_alloc(throttled);
+    }
+
+  return iob;
+}
+
+#endif /* IOB_HAVE_CLASSES */
@@ -44,11 +44,13 @@
  * Name: iob_next
  *
  * Description:
- *   Allocate or reinitialize the next node
+ *   Allocate or reinitialize the next node, which is to receive 'size'
+ *   more bytes
  *
  ****************************************************************************/
 
-static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
+static int iob_next(FAR struct iob_s *iob, unsigned int size,
+                    bool throttled, bool block)
 {
   FAR struct iob_s *next = iob->io_flink;
 
@@ -60,11 +62,11 @@ static int iob_next(FAR struct iob_s *iob, bool throttled, bool block)
     {
       if (block)
         {
-          next = iob_alloc(throttled);
+          next = iob_alloc_fit(size, throttled);
         }
       else
         {
-          next = iob_tryalloc(throttled);
+          next = iob_tryalloc_fit(size, throttled);
         }
 
       if (next == NULL)
@@ -150,7 +152,7 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
       iob2->io_len = avail2;
       offset2     -= iob2->io_len;
 
-      ret = iob_next(iob2, throttled, block);
+      ret = iob_next(iob2, offset2 + len, throttled, block);
       if (ret < 0)
         {
           return ret;
@@ -223,7 +225,7 @@ int iob_clone_partial(FAR struct iob_s *iob1, unsigned int len,
       if ((int)(offset2 + iob2->io_offset - IOB_BUFSIZE(iob2)) >= 0 &&
           iob1 != NULL)
         {
-          ret = iob_next(iob2, throttled, block);
+          ret = iob_next(iob2, len, throttled, block);
           if (ret < 0)
             {
               return ret;
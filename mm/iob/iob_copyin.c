@@ -178,18 +178,19 @@ static int iob_copyin_internal(FAR struct iob_s *iob, FAR const uint8_t *src,
 
       if (len > 0 && !next)
         {
-          /* Yes.. allocate a new buffer.
+          /* Yes.. allocate a new buffer, as large as the remaining data
+           * if a size class allows it.
            *
            * Copy as many bytes as possible. Block if we're allowed.
            */
 
           if (can_block)
             {
-              next = iob_alloc(throttled);
+              next = iob_alloc_fit(len, throttled);
             }
           else
             {
-              next = iob_tryalloc(throttled);
+              next = iob_tryalloc_fit(len, throttled);
             }
 
           if (next == NULL)
@@ -120,6 +120,13 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
               next, next->io_pktlen, next->io_len);
     }
 
+#ifdef IOB_HAVE_CLASSES
+  if (iob_class_free(iob))
+    {
+      return next;
+    }
+#endif
+
 #ifdef CONFIG_IOB_ALLOC
   if (iob->io_free != NULL)
     {
@@ -165,4 +165,8 @@ void iob_initialize(void)
       g_iob_freeqlist = iobq;
     }
 #endif
+
+#ifdef IOB_HAVE_CLASSES
+  iob_class_initialize();
+#endif
 }
@@ -28,6 +28,7 @@
 #include <execinfo.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <syslog.h>
 
 #include <nuttx/kmalloc.h>
@@ -40,6 +41,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The number of blocks moved between a per-CPU magazine and the shared
+ * queue at a time, half a magazine leaves room for both directions.
+ */
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+#  define MEMPOOL_MAGAZINE_BATCH ((CONFIG_MM_MEMPOOL_MAGAZINE + 1) / 2)
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 #define MEMPOOL_MAGIC_FREE  0xAAAAAAAA
 #define MEMPOOL_MAGIC_ALLOC 0x55555555
@@ -98,6 +107,137 @@ static inline void mempool_add_queue(FAR struct mempool_s *pool,
     }
 }
 
+static void mempool_construct(FAR struct mempool_s *pool, FAR char *base,
+                              size_t nblks, size_t blocksize)
+{
+  if (pool->ctor != NULL)
+    {
+      while (nblks-- > 0)
+        {
+          pool->ctor(pool, base + blocksize * nblks);
+        }
+    }
+}
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+static inline bool mempool_magazine_enabled(FAR struct mempool_s *pool)
+{
+  /* Blocks parked in a magazine can't wake up a waiter on waitsem */
+
+  return !pool->wait || pool->expandsize != 0;
+}
+
+static FAR sq_entry_t *mempool_magazine_alloc(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_magazine_s *mag;
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  /* Only the owning CPU touches its magazine, disabling the local
+   * interrupts is enough to keep it consistent.
+   */
+
+  flags = up_irq_save();
+  mag = &pool->magazine[this_cpu()];
+  if (mag->count > 0)
+    {
+      mag->nhit++;
+    }
+  else
+    {
+      irqstate_t lflags = spin_lock_irqsave(&pool->lock);
+
+      /* Refill half a magazine with a single lock acquisition, the blocks
+       * cached by the magazines are accounted as allocated by the pool.
+       */
+
+      mag->nmiss++;
+      while (mag->count < MEMPOOL_MAGAZINE_BATCH)
+        {
+          blk = mempool_remove_queue(pool, &pool->queue);
+          if (blk == NULL)
+            {
+              break;
+            }
+
+          mag->blocks[mag->count++] = blk;
+        }
+
+      pool->nalloc += mag->count;
+      spin_unlock_irqrestore(&pool->lock, lflags);
+    }
+
+  blk = mag->count > 0 ? mag->blocks[--mag->count] : NULL;
+  up_irq_restore(flags);
+  return blk;
+}
+
+static void mempool_magazine_release(FAR struct mempool_s *pool,
+                                     FAR sq_entry_t *blk)
+{
+  FAR struct mempool_magazine_s *mag;
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  mag = &pool->magazine[this_cpu()];
+  if (mag->count == CONFIG_MM_MEMPOOL_MAGAZINE)
+    {
+      irqstate_t lflags = spin_lock_irqsave(&pool->lock);
+      size_t nblks = MEMPOOL_MAGAZINE_BATCH;
+
+      /* Drain the oldest half of the magazine back to the shared queue */
+
+      while (nblks-- > 0)
+        {
+          sq_addlast(mag->blocks[nblks], &pool->queue);
+        }
+
+      mag->count -= MEMPOOL_MAGAZINE_BATCH;
+      memmove(mag->blocks, mag->blocks + MEMPOOL_MAGAZINE_BATCH,
+              mag->count * sizeof(mag->blocks[0]));
+      pool->nalloc -= MEMPOOL_MAGAZINE_BATCH;
+      spin_unlock_irqrestore(&pool->lock, lflags);
+    }
+
+  mag->blocks[mag->count++] = blk;
+  up_irq_restore(flags);
+}
+
+static size_t mempool_magazine_count(FAR struct mempool_s *pool)
+{
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      count += pool->magazine[cpu].count;
+    }
+
+  return count;
+}
+
+static void mempool_magazine_flush(FAR struct mempool_s *pool)
+{
+  irqstate_t flags = spin_lock_irqsave(&pool->lock);
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      FAR struct mempool_magazine_s *mag = &pool->magazine[cpu];
+
+      pool->nalloc -= mag->count;
+      while (mag->count > 0)
+        {
+          sq_addlast(mag->blocks[--mag->count], &pool->queue);
+        }
+    }
+
+  spin_unlock_irqrestore(&pool->lock, flags);
+}
+#else
+#  define mempool_magazine_count(pool) 0
+#endif
+
 #if CONFIG_MM_BACKTRACE >= 0
 static inline void mempool_add_backtrace(FAR struct mempool_s *pool,
                                          FAR struct mempool_backtrace_s *buf)
@@ -258,6 +398,9 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
   sq_init(&pool->iqueue);
   sq_init(&pool->equeue);
   pool->nalloc = 0;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  memset(pool->magazine, 0, sizeof(pool->magazine));
+#endif
   if (pool->interruptsize >= blocksize)
     {
       size_t ninterrupt = pool->interruptsize / blocksize;
@@ -269,6 +412,7 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
           return -ENOMEM;
         }
 
+      mempool_construct(pool, pool->ibase, ninterrupt, blocksize);
       mempool_add_queue(pool, &pool->iqueue,
                         pool->ibase, ninterrupt, blocksize);
       kasan_poison(pool->ibase, size);
@@ -295,6 +439,7 @@ int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
           return -ENOMEM;
         }
 
+      mempool_construct(pool, base, ninitial, blocksize);
       mempool_add_queue(pool, &pool->queue,
                         base, ninitial, blocksize);
       sq_addlast((FAR sq_entry_t *)(base + ninitial * blocksize),
@@ -342,6 +487,17 @@ FAR void *mempool_allocate(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   irqstate_t flags;
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  if (mempool_magazine_enabled(pool))
+    {
+      blk = mempool_magazine_alloc(pool);
+      if (blk != NULL)
+        {
+          goto out;
+        }
+    }
+#endif
+
 retry:
   flags = spin_lock_irqsave(&pool->lock);
   blk = mempool_remove_queue(pool, &pool->queue);
@@ -373,6 +529,7 @@ retry:
                   return NULL;
                 }
 
+              mempool_construct(pool, base, nexpand, blocksize);
               kasan_poison(base, size);
               flags = spin_lock_irqsave(&pool->lock);
               mempool_add_queue(pool, &pool->queue,
@@ -395,9 +552,18 @@ retry:
 
   pool->nalloc++;
   spin_unlock_irqrestore(&pool->lock, flags);
+
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+out:
+#endif
   blk = kasan_unpoison(blk, pool->blocksize);
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
-  memset(blk, MM_ALLOC_MAGIC, pool->blocksize);
+  /* Constructed blocks are handed out in the state they were released */
+
+  if (pool->ctor == NULL)
+    {
+      memset(blk, MM_ALLOC_MAGIC, pool->blocksize);
+    }
 #endif
 
 #if CONFIG_MM_BACKTRACE >= 0
@@ -421,8 +587,8 @@ retry:
 
 void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 {
-  irqstate_t flags = spin_lock_irqsave(&pool->lock);
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
+  irqstate_t flags;
 #if CONFIG_MM_BACKTRACE >= 0
   FAR struct mempool_backtrace_s *buf =
     (FAR struct mempool_backtrace_s *)((FAR char *)blk + pool->blocksize);
@@ -434,26 +600,37 @@ void mempool_release(FAR struct mempool_s *pool, FAR void *blk)
 
 #endif
 
-  pool->nalloc--;
-
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
-  memset(blk, MM_FREE_MAGIC, pool->blocksize);
+  if (pool->ctor == NULL)
+    {
+      memset(blk, MM_FREE_MAGIC, pool->blocksize);
+    }
 #endif
 
-  if (pool->interruptsize > blocksize)
+  if (pool->interruptsize > blocksize &&
+      (FAR char *)blk >= pool->ibase &&
+      (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize)
     {
-      if ((FAR char *)blk >= pool->ibase &&
-          (FAR char *)blk < pool->ibase + pool->interruptsize - blocksize)
-        {
-          sq_addlast(blk, &pool->iqueue);
-        }
-      else
-        {
-          sq_addlast(blk, &pool->queue);
-        }
+      flags = spin_lock_irqsave(&pool->lock);
+      pool->nalloc--;
+      sq_addlast(blk, &pool->iqueue);
     }
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  else if (mempool_magazine_enabled(pool))
+    {
+      /* Poison before publishing, the magazine may hand the block out
+       * again as soon as the local interrupts are restored.
+       */
+
+      kasan_poison(blk, pool->blocksize);
+      mempool_magazine_release(pool, blk);
+      return;
+    }
+#endif
   else
     {
+      flags = spin_lock_irqsave(&pool->lock);
+      pool->nalloc--;
       sq_addlast(blk, &pool->queue);
     }
 
@@ -489,17 +666,32 @@ int mempool_info(FAR struct mempool_s *pool, FAR struct mempoolinfo_s *info)
 {
   size_t blocksize = MEMPOOL_REALBLOCKSIZE(pool);
   irqstate_t flags;
+  size_t cached;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  int cpu;
+#endif
 
   DEBUGASSERT(pool != NULL && info != NULL);
 
   flags = spin_lock_irqsave(&pool->lock);
-  info->ordblks = sq_count(&pool->queue);
+  cached = mempool_magazine_count(pool);
+  info->ordblks = sq_count(&pool->queue) + cached;
   info->iordblks = sq_count(&pool->iqueue);
-  info->aordblks = pool->nalloc;
+  info->aordblks = pool->nalloc - cached;
   info->arena = sq_count(&pool->equeue) * sizeof(sq_entry_t) +
     (info->aordblks + info->ordblks + info->iordblks) * blocksize;
   spin_unlock_irqrestore(&pool->lock, flags);
   info->sizeblks = blocksize;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  info->nhit = 0;
+  info->nmiss = 0;
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      info->nhit += pool->magazine[cpu].nhit;
+      info->nmiss += pool->magazine[cpu].nmiss;
+    }
+#endif
+
   if (pool->wait && pool->expandsize == 0)
     {
       int semcount;
@@ -533,7 +725,8 @@ mempool_info_task(FAR struct mempool_s *pool,
     {
       irqstate_t flags = spin_lock_irqsave(&pool->lock);
       size_t count = sq_count(&pool->queue) +
-                     sq_count(&pool->iqueue);
+                     sq_count(&pool->iqueue) +
+                     mempool_magazine_count(pool);
 
       spin_unlock_irqrestore(&pool->lock, flags);
       info.aordblks += count;
@@ -541,8 +734,10 @@ mempool_info_task(FAR struct mempool_s *pool,
     }
   else if (task->pid == PID_MM_ALLOC)
     {
-      info.aordblks += pool->nalloc;
-      info.uordblks += pool->nalloc * blocksize;
+      size_t nalloc = pool->nalloc - mempool_magazine_count(pool);
+
+      info.aordblks += nalloc;
+      info.uordblks += nalloc * blocksize;
     }
 #if CONFIG_MM_BACKTRACE >= 0
   else
@@ -611,6 +806,10 @@ int mempool_deinit(FAR struct mempool_s *pool)
   FAR sq_entry_t *blk;
   size_t count = 0;
 
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  mempool_magazine_flush(pool);
+#endif
+
   if (pool->nalloc != 0)
     {
       return -EBUSY;
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * mm/mempool/mempool_create.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <sys/param.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR void *mempool_create_alloc(FAR struct mempool_s *pool,
+                                      size_t size)
+{
+  return kmm_memalign(MEMPOOL_ALIGN, size);
+}
+
+static void mempool_create_free(FAR struct mempool_s *pool, FAR void *addr)
+{
+  kmm_free(addr);
+}
+
+static void mempool_create_check(FAR struct mempool_s *pool,
+                                 FAR void *addr)
+{
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_create
+ *
+ * Description:
+ *   Create a memory pool of fixed-size kernel objects backed by the kernel
+ *   heap.  See include/nuttx/mm/mempool.h for the constructor rules.
+ *
+ * Input Parameters:
+ *   name      - The name of memory pool.
+ *   blocksize - The size of one object.
+ *   ninitial  - The number of objects allocated at creation.
+ *   nexpand   - The number of objects allocated each time the pool runs
+ *               out of blocks, 0 to never expand.
+ *   ctor      - The constructor of new objects, or NULL.
+ *   priv      - The user's private data, available as pool->priv.
+ *
+ * Returned Value:
+ *   The memory pool on success; NULL on any failure.
+ *
+ ****************************************************************************/
+
+FAR struct mempool_s *mempool_create(FAR const char *name, size_t blocksize,
+                                     size_t ninitial, size_t nexpand,
+                                     mempool_ctor_t ctor, FAR void *priv)
+{
+  FAR struct mempool_s *pool;
+  size_t realsize;
+
+  DEBUGASSERT(blocksize > 0 && (ninitial > 0 || nexpand > 0));
+
+  pool = kmm_zalloc(sizeof(struct mempool_s));
+  if (pool == NULL)
+    {
+      return NULL;
+    }
+
+  /* A free block holds the link of the free queue */
+
+  pool->blocksize = ALIGN_UP(MAX(blocksize, sizeof(sq_entry_t)),
+                             sizeof(uintptr_t));
+  realsize        = MEMPOOL_REALBLOCKSIZE(pool);
+
+  if (ninitial > 0)
+    {
+      pool->initialsize = ninitial * realsize + sizeof(sq_entry_t);
+    }
+
+  if (nexpand > 0)
+    {
+      pool->expandsize = nexpand * realsize + sizeof(sq_entry_t);
+    }
+
+  pool->priv  = priv;
+  pool->alloc = mempool_create_alloc;
+  pool->free  = mempool_create_free;
+  pool->check = mempool_create_check;
+  pool->ctor  = ctor;
+
+  if (mempool_init(pool, name) < 0)
+    {
+      kmm_free(pool);
+      return NULL;
+    }
+
+  return pool;
+}
+
+/****************************************************************************
+ * Name: mempool_destroy
+ *
+ * Description:
+ *   Destroy a memory pool created by mempool_create().
+ *
+ * Input Parameters:
+ *   pool    - Address of the memory pool to be used.
+ *
+ * Returned Value:
+ *   OK on success; -EBUSY if some objects are still allocated.
+ *
+ ****************************************************************************/
+
+int mempool_destroy(FAR struct mempool_s *pool)
+{
+  int ret;
+
+  ret = mempool_deinit(pool);
+  if (ret >= 0)
+    {
+      kmm_free(pool);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
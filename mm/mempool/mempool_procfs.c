@@ -26,6 +26,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/param.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -141,10 +142,17 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
 
   offset    = filep->f_pos;
   procfile  = filep->f_priv;
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+  linesize  = procfs_snprintf(procfile->line, MEMPOOLINFO_LINELEN,
+                              "%13s%11s%9s%9s%9s%9s%9s%6s\n", "", "total",
+                              "bsize", "nused", "nfree", "nifree",
+                              "nwaiter", "hit%");
+#else
   linesize  = procfs_snprintf(procfile->line, MEMPOOLINFO_LINELEN,
                               "%13s%11s%9s%9s%9s%9s%9s\n", "", "total",
                               "bsize", "nused", "nfree", "nifree",
                               "nwaiter");
+#endif
 
   copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
                             &offset);
@@ -162,12 +170,24 @@ static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
           buflen    -= copysize;
 
           mempool_info(pool, &minfo);
+#if CONFIG_MM_MEMPOOL_MAGAZINE > 0
+          linesize   = procfs_snprintf(procfile->line, MEMPOOLINFO_LINELEN,
+                                       "%12s:%11lu%9lu%9lu%9lu%9lu%9lu"
+                                       "%6lu\n",
+                                       entry->name, minfo.arena,
+                                       minfo.sizeblks, minfo.aordblks,
+                                       minfo.ordblks, minfo.iordblks,
+                                       minfo.nwaiter,
+                                       minfo.nhit * 100 /
+                                       MAX(minfo.nhit + minfo.nmiss, 1ul));
+#else
           linesize   = procfs_snprintf(procfile->line, MEMPOOLINFO_LINELEN,
                                        "%12s:%11lu%9lu%9lu%9lu%9lu%9lu\n",
                                        entry->name, minfo.arena,
                                        minfo.sizeblks, minfo.aordblks,
                                        minfo.ordblks, minfo.iordblks,
                                        minfo.nwaiter);
+#endif
           copysize   = procfs_memcpy(procfile->line, linesize, buffer,
                                      buflen, &offset);
           totalsize += copysize;
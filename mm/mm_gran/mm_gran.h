@@ -44,8 +44,11 @@
 
 #define SIZEOF_GAT(n) \
   ((n + 31) >> 5)
+#define SIZEOF_GSUM(n) \
+  SIZEOF_GAT(SIZEOF_GAT(n))
 #define SIZEOF_GRAN_S(n) \
-  (sizeof(struct gran_s) + sizeof(uint32_t) * (SIZEOF_GAT(n) - 1))
+  (sizeof(struct gran_s) + \
+   sizeof(uint32_t) * (SIZEOF_GAT(n) + 2 * SIZEOF_GSUM(n) - 1))
 
 /* Debug */
 
@@ -77,6 +80,14 @@ struct gran_s
   mutex_t    lock;       /* For exclusive access to the GAT */
 #endif
   uintptr_t  heapstart; /* The aligned start of the granule heap */
+
+  /* Summaries of the GAT with one bit per GAT cell, kept right after the
+   * GAT: gused marks the cells with any granule in use, gfull the cells
+   * with all of their granules in use.
+   */
+
+  FAR uint32_t *gused;
+  FAR uint32_t *gfull;
   uint32_t   gat[1];    /* Start of the granule allocation table */
 };
 
@@ -137,6 +137,8 @@ GRAN_HANDLE gran_initialize(FAR void *heapstart, size_t heapsize,
       priv->log2align = log2align;
       priv->ngranules = ngranules;
       priv->heapstart = alignedstart;
+      priv->gused     = &priv->gat[SIZEOF_GAT(ngranules)];
+      priv->gfull     = priv->gused + SIZEOF_GSUM(ngranules);
 
       /* Initialize mutual exclusion support */
 
@@ -90,6 +90,102 @@ uint32_t lsb_mask(uint32_t n)
   return (-n & n) & GATCFULL;
 }
 
+/* return MSB(n) and LSB(n) */
+
+static uint32_t msb_index(uint32_t n)
+{
+#ifdef CONFIG_HAVE_BUILTIN_CLZ
+  return 31 - __builtin_clz(n);
+#else
+  return DEBRUJIN_LUT[(uint32_t)(msb_mask(n) * DEBRUJIN_NUM) >> 27];
+#endif
+}
+
+static uint32_t lsb_index(uint32_t n)
+{
+#ifdef CONFIG_HAVE_BUILTIN_CTZ
+  return __builtin_ctz(n);
+#else
+  return DEBRUJIN_LUT[(uint32_t)(lsb_mask(n) * DEBRUJIN_NUM) >> 27];
+#endif
+}
+
+/* set or clear the bit of a GAT cell in a summary map */
+
+static void gsum_set(uint32_t *map, uint32_t cell, bool val)
+{
+  if (val)
+    {
+      map[cell >> 5] |= BIT(cell & 31);
+    }
+  else
+    {
+      map[cell >> 5] &= ~BIT(cell & 31);
+    }
+}
+
+/* return the last cell within [lo, hi] whose summary bit is set, or clear
+ * if inv is true, UINT32_MAX if there is none.
+ */
+
+static uint32_t gsum_last(const uint32_t *map, uint32_t lo, uint32_t hi,
+                          bool inv)
+{
+  uint32_t bits;
+  uint32_t w;
+
+  for (; ; )
+    {
+      w    = hi >> 5;
+      bits = (inv ? ~map[w] : map[w]) & (GATCFULL >> (31 - (hi & 31)));
+      if (w == lo >> 5)
+        {
+          bits &= GATCFULL << (lo & 31);
+          break;
+        }
+
+      if (bits)
+        {
+          break;
+        }
+
+      hi = (w << 5) - 1;
+    }
+
+  return bits ? (w << 5) + msb_index(bits) : UINT32_MAX;
+}
+
+/* return the first granule from posi on that is not in a full cell */
+
+static size_t gran_skipfull(const gran_t *gran, size_t posi)
+{
+  uint32_t ncell = SIZEOF_GAT(gran->ngranules);
+  uint32_t c = posi / GATC_BITS(gran);
+  uint32_t bits;
+
+  if (c >= ncell || !(gran->gfull[c >> 5] & BIT(c & 31)))
+    {
+      return posi;
+    }
+
+  /* skip 32 full cells at a time */
+
+  bits = ~gran->gfull[c >> 5] & (GATCFULL << (c & 31));
+  while (bits == 0)
+    {
+      c = (c | 31) + 1;
+      if (c >= ncell)
+        {
+          return gran->ngranules;
+        }
+
+      bits = ~gran->gfull[c >> 5];
+    }
+
+  c = (c & ~31) + lsb_index(bits);
+  return (size_t)c * GATC_BITS(gran);
+}
+
 /* set or clear a GAT cell with given bit mask */
 
 static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
@@ -102,6 +198,9 @@ static void cell_set(gran_t *gran, uint32_t cell, uint32_t mask, bool val)
     {
       gran->gat[cell] &= ~mask;
     }
+
+  gsum_set(gran->gused, cell, gran->gat[cell] != 0);
+  gsum_set(gran->gfull, cell, gran->gat[cell] == GATCFULL);
 }
 
 /* set or clear a range of GAT bits */
@@ -191,15 +290,15 @@ bool gran_match(const gran_t *gran, size_t posi, size_t size, bool used,
       return true;
     }
 
-  /* check cells in between */
+  /* check cells in between through the summary maps */
 
-  c = r.eidx - 1;
-  e = used ? GATCFULL : 0;
-  for (; c > r.sidx; c--)
+  if (r.eidx - r.sidx > 1)
     {
-      v = gran->gat[c];
-      if (v != e)
+      c = used ? gsum_last(gran->gfull, r.sidx + 1, r.eidx - 1, true) :
+                 gsum_last(gran->gused, r.sidx + 1, r.eidx - 1, false);
+      if (c != UINT32_MAX)
         {
+          v = gran->gat[c];
           goto failure;
         }
     }
@@ -223,14 +322,7 @@ failure:
       /* offset of last used when matching for free */
 
       DEBUGASSERT(v);
-#ifdef CONFIG_HAVE_BUILTIN_CLZ
-      *mpos = 31 - __builtin_clz(v);
-#else
-      *mpos = (uint32_t)((msb_mask(v)) * DEBRUJIN_NUM) >> 27;
-      DEBUGASSERT(*mpos < sizeof(DEBRUJIN_LUT));
-      *mpos = DEBRUJIN_LUT[*mpos];
-#endif
-      *mpos += c * GATC_BITS(gran);
+      *mpos = msb_index(v) + c * GATC_BITS(gran);
     }
 
   return false;
@@ -247,8 +339,13 @@ int gran_search(const gran_t *gran, size_t size)
       return ret;
     }
 
+  /* fully used cells are skipped without looking at them, and a failed
+   * match resumes after the last used granule it found.
+   */
+
   ret = -ENOMEM;
-  for (size_t i = 0; i <= gran->ngranules - size; i++)
+  for (size_t i = gran_skipfull(gran, 0); i + size <= gran->ngranules;
+       i = gran_skipfull(gran, i + 1))
     {
       if (gran_match(gran, i, size, 0, &i))
         {
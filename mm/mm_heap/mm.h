@@ -114,6 +114,17 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Each of the MM_NNODES power-of-two size classes is split again into
+ * MM_NSUBNODES free lists of linearly increasing size, the way TLSF does.
+ * MM_SUBNODE_SIZE(ndx) is the size range covered by one list of class ndx.
+ */
+
+#define MM_SUBNODE_SHIFT (3)
+#define MM_NSUBNODES     (1 << MM_SUBNODE_SHIFT)
+#define MM_NFREELISTS    (MM_NNODES * MM_NSUBNODES)
+#define MM_SUBNODE_SIZE(ndx) \
+  ((size_t)1 << ((ndx) + MM_MIN_SHIFT - MM_SUBNODE_SHIFT))
+
 #if CONFIG_MM_DEFAULT_ALIGNMENT == 0
 #  define MM_ALIGN       (2 * sizeof(uintptr_t))
 #else
@@ -161,6 +172,40 @@
 #define MM_PREVNODE_IS_ALLOC(node) (((node)->size & MM_PREVFREE_BIT) == 0)
 #define MM_PREVNODE_IS_FREE(node) (((node)->size & MM_PREVFREE_BIT) != 0)
 
+/* The per-CPU cache of small free chunks is protected by disabling
+ * interrupts, so it is only usable where that is allowed.  Cached chunks
+ * stay allocated in the heap; bin N holds the chunks whose size is at
+ * least MM_TCACHE_MINCHUNK + N * MM_ALIGN.
+ */
+
+#if defined(CONFIG_MM_HEAP_TCACHE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_USE_TCACHE
+#endif
+
+#ifdef CONFIG_MM_HEAP_TCACHE
+#  define MM_TCACHE_MINCHUNK MM_ALIGN_UP(MM_MIN_CHUNK)
+#  define MM_TCACHE_MAXCHUNK \
+     (MM_ALIGN_UP(CONFIG_MM_HEAP_TCACHE_MAXSIZE + MM_ALLOCNODE_OVERHEAD) > \
+      MM_TCACHE_MINCHUNK ? \
+      MM_ALIGN_UP(CONFIG_MM_HEAP_TCACHE_MAXSIZE + MM_ALLOCNODE_OVERHEAD) : \
+      MM_TCACHE_MINCHUNK)
+#  define MM_TCACHE_NBINS \
+     ((MM_TCACHE_MAXCHUNK - MM_TCACHE_MINCHUNK) / MM_ALIGN + 1)
+#  define MM_TCACHE_NDX(size) (((size) - MM_TCACHE_MINCHUNK) / MM_ALIGN)
+#endif
+
+/* Check if an allocated node is held by the cache (only known when the
+ * node records its owner)
+ */
+
+#if defined(MM_USE_TCACHE) && CONFIG_MM_BACKTRACE >= 0
+#  define MM_NODE_IS_CACHED(node) \
+     (MM_NODE_IS_ALLOC(node) && (node)->pid == PID_MM_TCACHE)
+#else
+#  define MM_NODE_IS_CACHED(node) (false)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -212,11 +257,27 @@ static_assert(MM_ALIGN >= sizeof(uintptr_t) &&
               (MM_ALIGN & MM_GRAN_MASK) == 0,
               "Error memory alignment\n");
 
+static_assert(MM_NNODES <= 32 && MM_NSUBNODES <= 16 &&
+              MM_MIN_SHIFT >= MM_SUBNODE_SHIFT,
+              "Error free list bitmap size\n");
+
 struct mm_delaynode_s
 {
   FAR struct mm_delaynode_s *flink;
 };
 
+/* This describes the small chunk cache of one CPU */
+
+#ifdef CONFIG_MM_HEAP_TCACHE
+struct mm_tcache_s
+{
+  FAR struct mm_delaynode_s *bin[MM_TCACHE_NBINS]; /* Cached chunks */
+  uint8_t count[MM_TCACHE_NBINS];                  /* Chunks in each bin */
+  size_t  nbytes;                                  /* Total chunk size */
+  size_t  nchunks;                                 /* Total chunks */
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -246,12 +307,15 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
-  /* All free nodes are maintained in a doubly linked list.  This
-   * array provides some hooks into the list at various points to
-   * speed up searching of free nodes.
+  /* Free nodes are kept in MM_NFREELISTS segregated, doubly linked lists
+   * (see mm_size2list()).  mm_nodemap has one bit per non-empty size
+   * class and mm_submap[ndx] one bit per non-empty list of class ndx, so
+   * that a fitting list is found in constant time.
    */
 
-  struct mm_freenode_s mm_nodelist[MM_NNODES];
+  uint32_t mm_nodemap;
+  uint32_t mm_submap[MM_NNODES];
+  FAR struct mm_freenode_s *mm_nodelist[MM_NFREELISTS];
 
   /* Free delay list, as sometimes we can't do free immdiately. */
 
@@ -261,6 +325,12 @@ struct mm_heap_s
   size_t mm_delaycount[CONFIG_SMP_NCPUS];
 #endif
 
+  /* Small free chunks kept back from the heap, per CPU */
+
+#ifdef CONFIG_MM_HEAP_TCACHE
+  struct mm_tcache_s mm_tcache[CONFIG_SMP_NCPUS];
+#endif
+
   /* The is a multiple mempool of the heap */
 
 #ifdef CONFIG_MM_HEAP_MEMPOOL
@@ -300,6 +370,16 @@ void mm_foreach(FAR struct mm_heap_s *heap, mm_node_handler_t handler,
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay);
+void mm_freelist(FAR struct mm_heap_s *heap, FAR struct mm_delaynode_s *list);
+
+/* Functions contained in mm_tcache.c ***************************************/
+
+#ifdef MM_USE_TCACHE
+FAR void *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+bool mm_tcache_flush(FAR struct mm_heap_s *heap);
+size_t mm_tcache_size(FAR struct mm_heap_s *heap, FAR size_t *nchunks);
+#endif
 
 /****************************************************************************
  * Inline Functions
@@ -317,40 +397,148 @@ static inline_function int mm_size2ndx(size_t size)
   return flsl(size) - 1;
 }
 
+/* Return the index of the free list holding the chunks of a given size */
+
+static inline_function int mm_size2list(size_t size)
+{
+  int ndx = mm_size2ndx(size);
+
+  /* The last class has no upper bound and is kept in a single list */
+
+  if (ndx == MM_NNODES - 1)
+    {
+      return ndx << MM_SUBNODE_SHIFT;
+    }
+
+  return (ndx << MM_SUBNODE_SHIFT) |
+         ((size >> (ndx + MM_MIN_SHIFT - MM_SUBNODE_SHIFT)) &
+          (MM_NSUBNODES - 1));
+}
+
 static inline_function void mm_addfreechunk(FAR struct mm_heap_s *heap,
                                             FAR struct mm_freenode_s *node)
 {
-  FAR struct mm_freenode_s *next;
-  FAR struct mm_freenode_s *prev;
   size_t nodesize = MM_SIZEOF_NODE(node);
-  int ndx;
+  int list;
 
   DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
   DEBUGASSERT(MM_NODE_IS_FREE(node));
 
-  /* Convert the size to a nodelist index */
+  /* Convert the size to a free list index */
 
-  ndx = mm_size2ndx(nodesize);
+  list = mm_size2list(nodesize);
 
-  /* Now put the new node into the next */
+  /* Put the new node at the head of its list and mark the list non-empty */
 
-  for (prev = &heap->mm_nodelist[ndx],
-       next = heap->mm_nodelist[ndx].flink;
-       next && next->size && MM_SIZEOF_NODE(next) < nodesize;
-       prev = next, next = next->flink);
+  node->blink = NULL;
+  node->flink = heap->mm_nodelist[list];
+  if (node->flink)
+    {
+      node->flink->blink = node;
+    }
 
-  /* Does it go in mid next or at the end? */
+  heap->mm_nodelist[list] = node;
+  heap->mm_nodemap |= 1u << (list >> MM_SUBNODE_SHIFT);
+  heap->mm_submap[list >> MM_SUBNODE_SHIFT] |=
+    1u << (list & (MM_NSUBNODES - 1));
+}
 
-  prev->flink = node;
-  node->blink = prev;
-  node->flink = next;
+static inline_function void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                                            FAR struct mm_freenode_s *node)
+{
+  int list = mm_size2list(MM_SIZEOF_NODE(node));
+  int ndx = list >> MM_SUBNODE_SHIFT;
+
+  DEBUGASSERT(MM_NODE_IS_FREE(node));
 
-  if (next)
+  /* Remove the node from its list.  There may be neither a predecessor
+   * (the node is the list head) nor a successor.
+   */
+
+  if (node->blink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+      node->blink->flink = node->flink;
+    }
+  else
     {
-      /* The new node goes between prev and next */
+      DEBUGASSERT(heap->mm_nodelist[list] == node);
+      heap->mm_nodelist[list] = node->flink;
+    }
 
-      next->blink = node;
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
     }
+
+  /* Clear the bitmaps if the list became empty */
+
+  if (heap->mm_nodelist[list] == NULL)
+    {
+      heap->mm_submap[ndx] &= ~(1u << (list & (MM_NSUBNODES - 1)));
+      if (heap->mm_submap[ndx] == 0)
+        {
+          heap->mm_nodemap &= ~(1u << ndx);
+        }
+    }
+}
+
+/* Return a free node of at least the given size, without removing it */
+
+static inline_function FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  int list = mm_size2list(size);
+  int ndx = list >> MM_SUBNODE_SHIFT;
+  int sub = list & (MM_NSUBNODES - 1);
+  uint32_t map;
+
+  /* Any node of a list above the one of size is large enough, and so is
+   * any node of that list itself if size is its lower bound (always true
+   * in the small classes, where a list holds a single aligned size).
+   * The bitmaps then give the first such non-empty list in constant time.
+   */
+
+  if (ndx < MM_NNODES - 1)
+    {
+      if ((size & (MM_SUBNODE_SIZE(ndx) - 1)) != 0)
+        {
+          sub++;
+        }
+
+      map = heap->mm_submap[ndx] & (UINT32_MAX << sub);
+      if (map == 0)
+        {
+          map = heap->mm_nodemap & (UINT32_MAX << (ndx + 1));
+          if (map != 0)
+            {
+              ndx = ffs(map) - 1;
+              map = heap->mm_submap[ndx];
+            }
+        }
+
+      if (map != 0)
+        {
+          return heap->mm_nodelist[(ndx << MM_SUBNODE_SHIFT) +
+                                   ffs(map) - 1];
+        }
+    }
+
+  /* Otherwise only the list of size itself may still hold a large enough
+   * node: this is the slow path of an almost exhausted heap, or of the
+   * unbounded last class.
+   */
+
+  for (node = heap->mm_nodelist[list]; node; node = node->flink)
+    {
+      if (MM_SIZEOF_NODE(node) >= size)
+        {
+          break;
+        }
+    }
+
+  return node;
 }
 
 #endif /* __MM_MM_HEAP_MM_H */
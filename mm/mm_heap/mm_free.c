@@ -70,18 +70,20 @@ static void add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_delayfree
+ * Name: free_node
  *
  * Description:
- *   Delay free memory if `delay` is true, otherwise free it immediately.
+ *   Return an allocated chunk to the free lists, merging it with adjacent
+ *   free chunks.  Chunks coming back from the tcache were already traced
+ *   as freed, 'note' is false for them.
+ *
+ * Assumptions:
+ *   Called with the heap locked.
  *
  ****************************************************************************/
 
-void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
+static void free_node(FAR struct mm_heap_s *heap, FAR void *mem,
+                      bool note)
 {
   FAR struct mm_freenode_s *node;
   FAR struct mm_freenode_s *prev;
@@ -89,42 +91,6 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
   size_t nodesize;
   size_t prevsize;
 
-  if (mm_lock(heap) < 0)
-    {
-      /* Meet -ESRCH return, which means we are in situations
-       * during context switching(See mm_lock() & gettid()).
-       * Then add to the delay list.
-       */
-
-      add_delaylist(heap, mem);
-      return;
-    }
-
-  nodesize = mm_malloc_size(heap, mem);
-#ifdef CONFIG_MM_FILL_ALLOCATIONS
-#if CONFIG_MM_FREE_DELAYCOUNT_MAX > 0
-  /* If delay free is enabled, a memory node will be freed twice.
-   * The first time is to add the node to the delay list, and the second
-   * time is to actually free the node. Therefore, we only colorize the
-   * memory node the first time, when `delay` is set to true.
-   */
-
-  if (delay)
-#endif
-    {
-      memset(mem, MM_FREE_MAGIC, nodesize);
-    }
-#endif
-
-  kasan_poison(mem, nodesize);
-
-  if (delay)
-    {
-      mm_unlock(heap);
-      add_delaylist(heap, mem);
-      return;
-    }
-
   /* Map the memory chunk into a free node */
 
   node = (FAR struct mm_freenode_s *)
@@ -140,7 +106,11 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
   /* Update heap statistics */
 
   heap->mm_curused -= nodesize;
-  sched_note_heap(NOTE_HEAP_FREE, heap, mem, nodesize, heap->mm_curused);
+  if (note)
+    {
+      sched_note_heap(NOTE_HEAP_FREE, heap, mem, nodesize,
+                      heap->mm_curused);
+    }
 
   /* Check if the following node is free and, if so, merge it */
 
@@ -160,16 +130,9 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
       DEBUGASSERT(MM_PREVNODE_IS_FREE(andbeyond) &&
                   andbeyond->preceding == nextsize);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from its free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -195,16 +158,9 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
       prevsize = MM_SIZEOF_NODE(prev);
       DEBUGASSERT(MM_NODE_IS_FREE(prev) && node->preceding == prevsize);
 
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the node from its free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -217,6 +173,93 @@ void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
   /* Add the merged node to the nodelist */
 
   mm_addfreechunk(heap, node);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_delayfree
+ *
+ * Description:
+ *   Delay free memory if `delay` is true, otherwise free it immediately.
+ *
+ ****************************************************************************/
+
+void mm_delayfree(FAR struct mm_heap_s *heap, FAR void *mem, bool delay)
+{
+  if (mm_lock(heap) < 0)
+    {
+      /* Meet -ESRCH return, which means we are in situations
+       * during context switching(See mm_lock() & gettid()).
+       * Then add to the delay list.
+       */
+
+      add_delaylist(heap, mem);
+      return;
+    }
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+#if CONFIG_MM_FREE_DELAYCOUNT_MAX > 0
+  /* If delay free is enabled, a memory node will be freed twice.
+   * The first time is to add the node to the delay list, and the second
+   * time is to actually free the node. Therefore, we only colorize the
+   * memory node the first time, when `delay` is set to true.
+   */
+
+  if (delay)
+#endif
+    {
+      memset(mem, MM_FREE_MAGIC, mm_malloc_size(heap, mem));
+    }
+#endif
+
+  kasan_poison(mem, mm_malloc_size(heap, mem));
+
+  if (delay)
+    {
+      mm_unlock(heap);
+      add_delaylist(heap, mem);
+      return;
+    }
+
+  free_node(heap, mem, true);
+  mm_unlock(heap);
+}
+
+/****************************************************************************
+ * Name: mm_freelist
+ *
+ * Description:
+ *   Free a list of chunks (linked through their first word, and already
+ *   filled/poisoned) under a single lock of the heap.
+ *
+ ****************************************************************************/
+
+void mm_freelist(FAR struct mm_heap_s *heap, FAR struct mm_delaynode_s *list)
+{
+  FAR struct mm_delaynode_s *next;
+
+  if (mm_lock(heap) < 0)
+    {
+      /* Leave them to the delay list, as mm_delayfree() does */
+
+      for (; list != NULL; list = next)
+        {
+          next = list->flink;
+          add_delaylist(heap, list);
+        }
+
+      return;
+    }
+
+  for (; list != NULL; list = next)
+    {
+      next = list->flink;
+      free_node(heap, list, false);
+    }
+
   mm_unlock(heap);
 }
 
@@ -252,5 +295,12 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
     }
 #endif
 
+#ifdef MM_USE_TCACHE
+  if (mm_tcache_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
   mm_delayfree(heap, mem, CONFIG_MM_FREE_DELAYCOUNT_MAX > 0);
 }
@@ -235,7 +235,6 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 {
   FAR struct mm_heap_s *heap;
   uintptr_t             heap_adj;
-  int                   i;
 
   minfo("Heap: name=%s, start=%p size=%zu\n", name, heapstart, heapsize);
 
@@ -253,18 +252,10 @@ FAR struct mm_heap_s *mm_initialize(FAR const char *name,
 
   DEBUGASSERT(MM_MIN_CHUNK >= MM_SIZEOF_ALLOCNODE);
 
-  /* Set up global variables */
+  /* Set up global variables.  This also leaves all the free lists empty. */
 
   memset(heap, 0, sizeof(struct mm_heap_s));
 
-  /* Initialize the node array */
-
-  for (i = 1; i < MM_NNODES; i++)
-    {
-      heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
-      heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
-    }
-
   /* Initialize the malloc mutex to one (to support one-at-
    * a-time access to private data sets).
    */
@@ -69,13 +69,11 @@ static void mallinfo_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+      DEBUGASSERT(fnode->blink == NULL || fnode->blink->flink == fnode);
+      DEBUGASSERT(fnode->flink == NULL || fnode->flink->blink == fnode);
+      DEBUGASSERT(fnode->blink == NULL ||
+                  mm_size2list(MM_SIZEOF_NODE(fnode->blink)) ==
+                  mm_size2list(nodesize));
 
       info->ordblks++;
       info->fordblks += nodesize;
@@ -96,7 +94,17 @@ static void mallinfo_task_handler(FAR struct mm_allocnode_s *node,
 
   /* Check if the node corresponds to an allocated memory chunk */
 
-  if (MM_NODE_IS_ALLOC(node))
+  if (MM_NODE_IS_CACHED(node))
+    {
+      /* Held by the tcache, free from the user's point of view */
+
+      if (task->pid == PID_MM_FREE)
+        {
+          info->aordblks++;
+          info->uordblks += nodesize;
+        }
+    }
+  else if (MM_NODE_IS_ALLOC(node))
     {
       DEBUGASSERT(nodesize >= MM_SIZEOF_ALLOCNODE);
       if ((MM_DUMP_ASSIGN(task, node) || MM_DUMP_ALLOC(task, node) ||
@@ -131,6 +139,10 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
 #ifdef CONFIG_MM_HEAP_MEMPOOL
   struct mallinfo poolinfo;
 #endif
+#ifdef MM_USE_TCACHE
+  size_t nchunks;
+  size_t nbytes;
+#endif
 
   memset(&info, 0, sizeof(info));
   mm_foreach(heap, mallinfo_handler, &info);
@@ -146,6 +158,16 @@ struct mallinfo mm_mallinfo(FAR struct mm_heap_s *heap)
   info.fordblks += poolinfo.fordblks;
 #endif
 
+#ifdef MM_USE_TCACHE
+  /* Chunks in the tcache look allocated in the heap, but are free */
+
+  nbytes = mm_tcache_size(heap, &nchunks);
+  info.aordblks -= nchunks;
+  info.uordblks -= nbytes;
+  info.ordblks  += nchunks;
+  info.fordblks += nbytes;
+#endif
+
   DEBUGASSERT(info.uordblks + info.fordblks == info.arena);
 
   return info;
@@ -190,7 +212,11 @@ struct mallinfo_task mm_mallinfo_task(FAR struct mm_heap_s *heap,
 
 size_t mm_heapfree(FAR struct mm_heap_s *heap)
 {
+#ifdef MM_USE_TCACHE
+  return heap->mm_heapsize - heap->mm_curused + mm_tcache_size(heap, NULL);
+#else
   return heap->mm_heapsize - heap->mm_curused;
+#endif
 }
 
 /****************************************************************************
@@ -204,15 +230,29 @@ size_t mm_heapfree(FAR struct mm_heap_s *heap)
 size_t mm_heapfree_largest(FAR struct mm_heap_s *heap)
 {
   FAR struct mm_freenode_s *node;
-  for (node = heap->mm_nodelist[MM_NNODES - 1].blink; node;
-       node = node->blink)
+  size_t largest = 0;
+  int ndx;
+
+  /* The largest chunk is in the highest non-empty list, which is not
+   * sorted by size.
+   */
+
+  if (heap->mm_nodemap == 0)
+    {
+      return 0;
+    }
+
+  ndx = fls(heap->mm_nodemap) - 1;
+  for (node = heap->mm_nodelist[(ndx << MM_SUBNODE_SHIFT) +
+                                fls(heap->mm_submap[ndx]) - 1];
+       node; node = node->flink)
     {
       size_t nodesize = MM_SIZEOF_NODE(node);
-      if (nodesize != 0)
+      if (nodesize > largest)
         {
-          return nodesize;
+          largest = nodesize;
         }
     }
 
-  return 0;
+  return largest;
 }
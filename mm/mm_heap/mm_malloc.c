@@ -153,6 +153,9 @@ void mm_free_delaylist(FAR struct mm_heap_s *heap)
   if (heap)
     {
        free_delaylist(heap, true);
+#ifdef MM_USE_TCACHE
+       mm_tcache_flush(heap);
+#endif
     }
 }
 
@@ -173,7 +176,6 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
   size_t alignsize;
   size_t nodesize;
   FAR void *ret = NULL;
-  int ndx;
 
   /* Free the delay list first */
 
@@ -210,32 +212,29 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   DEBUGASSERT(alignsize >= MM_ALIGN);
 
-  /* We need to hold the MM mutex while we muck with the nodelist. */
+#ifdef MM_USE_TCACHE
+  /* Reuse a chunk freed recently on this CPU, without the MM mutex */
 
-  DEBUGVERIFY(mm_lock(heap));
+  ret = mm_tcache_alloc(heap, alignsize);
+  if (ret != NULL)
+    {
+      return ret;
+    }
+#endif
 
-  /* Convert the request size into a nodelist index */
+  /* We need to hold the MM mutex while we muck with the nodelist. */
 
-  ndx = mm_size2ndx(alignsize);
+  DEBUGVERIFY(mm_lock(heap));
 
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
+  /* Find a large enough chunk in the free lists.  The bitmaps of non-empty
+   * lists bound the search, whatever the state of the heap.
    */
 
-  for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
-      nodesize = MM_SIZEOF_NODE(node);
-      if (nodesize >= alignsize)
-        {
-          break;
-        }
-    }
+  node = mm_findfreechunk(heap, alignsize);
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that it must be the best fitting chunk
-   * available.
+  /* If we found a node, then this is one to use.  It may not be the best
+   * fitting chunk available, but it is the first one of the smallest list
+   * whose chunks all fit.
    */
 
   if (node)
@@ -244,16 +243,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from its free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      nodesize = MM_SIZEOF_NODE(node);
+      mm_delfreechunk(heap, node);
 
       /* Get a pointer to the next node in physical memory */
 
@@ -351,6 +344,15 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef MM_USE_TCACHE
+  /* Try again after giving the cached chunks back, they may merge */
+
+  else if (mm_tcache_flush(heap))
+    {
+      return mm_malloc(heap, size);
+    }
+#endif
+
 #ifdef CONFIG_DEBUG_MM
   else if (MM_INTERNAL_HEAP(heap))
     {
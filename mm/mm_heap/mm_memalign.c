@@ -208,16 +208,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
           FAR struct mm_freenode_s *prev =
             (FAR struct mm_freenode_s *)((FAR char *)node - node->preceding);
 
-          /* Remove the node.  There must be a predecessor, but there may
-           * not be a successor node.
-           */
-
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          /* Remove the node from its free list */
+
+          mm_delfreechunk(heap, prev);
 
           precedingsize += MM_SIZEOF_NODE(prev);
           node = (FAR struct mm_allocnode_s *)prev;
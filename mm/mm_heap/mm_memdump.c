@@ -159,7 +159,20 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
   FAR const struct mm_memdump_s *dump = priv->dump;
   size_t nodesize = MM_SIZEOF_NODE(node);
 
-  if (MM_NODE_IS_ALLOC(node))
+  if (MM_NODE_IS_CACHED(node))
+    {
+      /* Held by the tcache, dumped along with the free nodes */
+
+      if (dump->pid == PID_MM_FREE)
+        {
+          priv->info.aordblks++;
+          priv->info.uordblks += nodesize;
+          syslog(LOG_INFO, "%12zu%*p\n",
+                 nodesize, BACKTRACE_PTR_FMT_WIDTH,
+                 ((FAR char *)node + MM_SIZEOF_ALLOCNODE));
+        }
+    }
+  else if (MM_NODE_IS_ALLOC(node))
     {
       DEBUGASSERT(nodesize >= MM_SIZEOF_ALLOCNODE);
       if ((MM_DUMP_ASSIGN(dump, node) || MM_DUMP_ALLOC(dump, node) ||
@@ -192,13 +205,11 @@ static void memdump_handler(FAR struct mm_allocnode_s *node, FAR void *arg)
       FAR struct mm_freenode_s *fnode = (FAR void *)node;
 
       DEBUGASSERT(nodesize >= MM_MIN_CHUNK);
-      DEBUGASSERT(fnode->blink->flink == fnode);
-      DEBUGASSERT(MM_SIZEOF_NODE(fnode->blink) <= nodesize);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  fnode->flink->blink == fnode);
-      DEBUGASSERT(fnode->flink == NULL ||
-                  MM_SIZEOF_NODE(fnode->flink) == 0 ||
-                  MM_SIZEOF_NODE(fnode->flink) >= nodesize);
+      DEBUGASSERT(fnode->blink == NULL || fnode->blink->flink == fnode);
+      DEBUGASSERT(fnode->flink == NULL || fnode->flink->blink == fnode);
+      DEBUGASSERT(fnode->blink == NULL ||
+                  mm_size2list(MM_SIZEOF_NODE(fnode->blink)) ==
+                  mm_size2list(nodesize));
 
       priv->info.aordblks++;
       priv->info.uordblks += nodesize;
@@ -0,0 +1,301 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tcache.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+#include <string.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/kasan.h>
+#include <nuttx/sched.h>
+#include <nuttx/sched_note.h>
+
+#include "mm_heap/mm.h"
+
+#ifdef MM_USE_TCACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcache_chunksize
+ *
+ * Description:
+ *   Return the node size of a cached chunk.
+ *
+ ****************************************************************************/
+
+static inline size_t tcache_chunksize(FAR struct mm_delaynode_s *chunk)
+{
+  return MM_SIZEOF_NODE((FAR struct mm_allocnode_s *)
+                        ((FAR char *)chunk - MM_SIZEOF_ALLOCNODE));
+}
+
+/****************************************************************************
+ * Name: tcache_detach
+ *
+ * Description:
+ *   Detach the chunks of a bin beyond the first 'keep' ones and append
+ *   them to a list.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled on the CPU owning the cache.
+ *
+ ****************************************************************************/
+
+static void tcache_detach(FAR struct mm_tcache_s *tcache, int ndx,
+                          int keep, FAR struct mm_delaynode_s **list)
+{
+  FAR struct mm_delaynode_s **tail = &tcache->bin[ndx];
+  FAR struct mm_delaynode_s *chunk;
+  int i;
+
+  for (i = 0; i < keep; i++)
+    {
+      tail = &(*tail)->flink;
+    }
+
+  while ((chunk = *tail) != NULL)
+    {
+      *tail = chunk->flink;
+      tcache->nbytes -= tcache_chunksize(chunk);
+      tcache->nchunks--;
+      tcache->count[ndx]--;
+
+      chunk->flink = *list;
+      *list = chunk;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tcache_alloc
+ *
+ * Description:
+ *   Take a chunk of the given (aligned, node) size from the cache of the
+ *   current CPU.
+ *
+ * Returned Value:
+ *   The allocated memory, or NULL if the bin is empty.
+ *
+ ****************************************************************************/
+
+FAR void *mm_tcache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_delaynode_s *chunk;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_tcache_s *tcache;
+  irqstate_t flags;
+  size_t nodesize = 0;
+  FAR void *ret;
+  int ndx;
+
+  if (size < MM_TCACHE_MINCHUNK || size > MM_TCACHE_MAXCHUNK)
+    {
+      return NULL;
+    }
+
+  ndx = MM_TCACHE_NDX(size);
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  chunk  = tcache->bin[ndx];
+  if (chunk != NULL)
+    {
+      nodesize          = tcache_chunksize(chunk);
+      tcache->bin[ndx]  = chunk->flink;
+      tcache->nbytes   -= nodesize;
+      tcache->nchunks--;
+      tcache->count[ndx]--;
+    }
+
+  up_irq_restore(flags);
+
+  if (chunk == NULL)
+    {
+      return NULL;
+    }
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)chunk - MM_SIZEOF_ALLOCNODE);
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node) && nodesize >= size);
+
+  MM_ADD_BACKTRACE(heap, node);
+  ret = kasan_unpoison(chunk, nodesize - MM_ALLOCNODE_OVERHEAD);
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(ret, MM_ALLOC_MAGIC, size - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  sched_note_heap(NOTE_HEAP_ALLOC, heap, ret, nodesize, heap->mm_curused);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_free
+ *
+ * Description:
+ *   Keep a small chunk in the cache of the current CPU.  When its bin is
+ *   full, the older half of the bin is given back to the heap.
+ *
+ * Returned Value:
+ *   True if the chunk was taken by the cache.
+ *
+ ****************************************************************************/
+
+bool mm_tcache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_delaynode_s *chunk = kasan_reset_tag(mem);
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_tcache_s *tcache;
+  irqstate_t flags;
+  size_t nodesize;
+  int ndx;
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)chunk - MM_SIZEOF_ALLOCNODE);
+  nodesize = MM_SIZEOF_NODE(node);
+  if (nodesize < MM_TCACHE_MINCHUNK || nodesize > MM_TCACHE_MAXCHUNK)
+    {
+      return false;
+    }
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(MM_NODE_IS_ALLOC(node) && !MM_NODE_IS_CACHED(node));
+
+  ndx = MM_TCACHE_NDX(nodesize);
+
+#ifdef CONFIG_MM_FILL_ALLOCATIONS
+  memset(chunk, MM_FREE_MAGIC, nodesize - MM_ALLOCNODE_OVERHEAD);
+#endif
+
+  kasan_poison(mem, nodesize - MM_ALLOCNODE_OVERHEAD);
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  if (tcache->count[ndx] >= CONFIG_MM_HEAP_TCACHE_COUNT)
+    {
+      tcache_detach(tcache, ndx, CONFIG_MM_HEAP_TCACHE_COUNT / 2, &list);
+    }
+
+#if CONFIG_MM_BACKTRACE >= 0
+  node->pid = PID_MM_TCACHE;
+#endif
+
+  chunk->flink      = tcache->bin[ndx];
+  tcache->bin[ndx]  = chunk;
+  tcache->nbytes   += nodesize;
+  tcache->nchunks++;
+  tcache->count[ndx]++;
+
+  up_irq_restore(flags);
+
+  sched_note_heap(NOTE_HEAP_FREE, heap, mem, nodesize, heap->mm_curused);
+
+  if (list != NULL)
+    {
+      mm_freelist(heap, list);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_flush
+ *
+ * Description:
+ *   Give all the chunks cached by the current CPU back to the heap.
+ *
+ * Returned Value:
+ *   True if there was any chunk in the cache.
+ *
+ ****************************************************************************/
+
+bool mm_tcache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_delaynode_s *list = NULL;
+  FAR struct mm_tcache_s *tcache;
+  irqstate_t flags;
+  int ndx;
+
+  flags  = up_irq_save();
+  tcache = &heap->mm_tcache[this_cpu()];
+  for (ndx = 0; ndx < MM_TCACHE_NBINS; ndx++)
+    {
+      tcache_detach(tcache, ndx, 0, &list);
+    }
+
+  up_irq_restore(flags);
+
+  if (list == NULL)
+    {
+      return false;
+    }
+
+  mm_freelist(heap, list);
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_tcache_size
+ *
+ * Description:
+ *   Return the total size of the chunks cached by all CPUs, and optionally
+ *   their number.  The chunks are allocated in the heap, so callers
+ *   reporting heap usage move this amount from used to free.
+ *
+ ****************************************************************************/
+
+size_t mm_tcache_size(FAR struct mm_heap_s *heap, FAR size_t *nchunks)
+{
+  size_t nbytes = 0;
+  size_t count = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      nbytes += heap->mm_tcache[cpu].nbytes;
+      count  += heap->mm_tcache[cpu].nchunks;
+    }
+
+  if (nchunks != NULL)
+    {
+      *nchunks = count;
+    }
+
+  return nbytes;
+}
+
+#endif /* MM_USE_TCACHE */
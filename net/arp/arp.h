@@ -419,7 +419,7 @@ void arp_notify(in_addr_t ipaddr);
  *   dev     - Device structure
  *
  * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ *   The network need not be locked.
  *
  ****************************************************************************/
 
@@ -56,6 +56,9 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/nuttx.h>
+#include <nuttx/queue.h>
+#include <nuttx/seqlock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -83,13 +86,33 @@ struct arp_table_info_s
   FAR uint8_t *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One ARP table entry with its hash chain and LRU list links */
+
+struct arp_node_s
+{
+  struct arp_entry_s     an_entry;  /* The address mapping */
+  dq_entry_t             an_lru;    /* Least recently updated first */
+  FAR struct arp_node_s *an_hnext;  /* Next entry in the same bucket */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The table of known address mappings.  Entries are handed out in array
+ * order, reused from the free list once deleted and, when the table is
+ * full, recycled least recently updated first.
+ *
+ * All modifications are made with the network locked; g_arpseq lets
+ * arp_find() read the table without the lock.
+ */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static struct arp_node_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static FAR struct arp_node_s *g_arphash[CONFIG_NET_ARP_HASH_SIZE];
+static FAR struct arp_node_s *g_arpfree;
+static dq_queue_t g_arplru;
+static unsigned int g_arpnused;
+static seqcount_t g_arpseq = SEQCOUNT_INITIALIZER;
 
 static const struct ether_addr g_zero_ethaddr =
 {
@@ -149,32 +172,98 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_bucket
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return the hash chain that holds the entries of an IP address.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static inline FAR struct arp_node_s **arp_bucket(in_addr_t ipaddr)
 {
-  if (e1->at_ipaddr == 0)
-    {
-      return e1;
-    }
-  else if (e2->at_ipaddr == 0)
-    {
-      return e2;
-    }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+  uint32_t hash = (uint32_t)ipaddr;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_arphash[(hash & 0xff) % CONFIG_NET_ARP_HASH_SIZE];
+}
+
+/****************************************************************************
+ * Name: arp_findnode
+ *
+ * Description:
+ *   Find the (possibly expired) ARP table entry of an IP address on a
+ *   device.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_node_s *arp_findnode(in_addr_t ipaddr,
+                                           FAR struct net_driver_s *dev)
+{
+  FAR struct arp_node_s *node;
+
+  for (node = *arp_bucket(ipaddr); node != NULL; node = node->an_hnext)
     {
-      return e1;
+      if (node->an_entry.at_dev == dev &&
+          net_ipv4addr_cmp(ipaddr, node->an_entry.at_ipaddr))
+        {
+          return node;
+        }
     }
-  else
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_unlink
+ *
+ * Description:
+ *   Remove an entry from its hash chain and from the LRU list.
+ *
+ * Assumptions:
+ *   The network is locked and a write section of g_arpseq is open.
+ *
+ ****************************************************************************/
+
+static void arp_unlink(FAR struct arp_node_s *node)
+{
+  FAR struct arp_node_s **pnode = arp_bucket(node->an_entry.at_ipaddr);
+
+  while (*pnode != NULL)
     {
-      return e2;
+      if (*pnode == node)
+        {
+          *pnode = node->an_hnext;
+          break;
+        }
+
+      pnode = &(*pnode)->an_hnext;
     }
+
+  node->an_hnext = NULL;
+  dq_rem(&node->an_lru, &g_arplru);
+}
+
+/****************************************************************************
+ * Name: arp_release
+ *
+ * Description:
+ *   Unlink an entry and put it on the free list.
+ *
+ * Assumptions:
+ *   The network is locked and a write section of g_arpseq is open.
+ *
+ ****************************************************************************/
+
+static void arp_release(FAR struct arp_node_s *node)
+{
+  arp_unlink(node);
+  node->an_entry.at_ipaddr = 0;
+  node->an_hnext = g_arpfree;
+  g_arpfree = node;
 }
 
 /****************************************************************************
@@ -193,28 +282,73 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
-                                          FAR struct net_driver_s *dev)
+static FAR struct arp_node_s *arp_lookup(in_addr_t ipaddr,
+                                         FAR struct net_driver_s *dev)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_node_s *node = arp_findnode(ipaddr, dev);
 
-  /* Check if the IPv4 address is already in the ARP table. */
+  if (node != NULL &&
+      clock_systime_ticks() - node->an_entry.at_time <= ARP_MAXAGE_TICK)
+    {
+      return node;
+    }
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: arp_find_table
+ *
+ * Description:
+ *   Look an IP address up in the ARP table and copy out its MAC address.
+ *   This may run concurrently with a modification of the table; the
+ *   caller detects that with g_arpseq and retries with the network locked.
+ *   The walk is bounded so that a chain changing under it cannot loop.
+ *
+ ****************************************************************************/
+
+static int arp_find_table(in_addr_t ipaddr, FAR uint8_t *ethaddr,
+                          FAR struct net_driver_s *dev)
+{
+  FAR struct arp_node_s *node;
+  unsigned int n = 0;
+
+  for (node = *arp_bucket(ipaddr);
+       node != NULL && n < CONFIG_NET_ARPTAB_SIZE;
+       node = node->an_hnext, n++)
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_dev == dev &&
-          net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
+      FAR struct arp_entry_s *tabptr = &node->an_entry;
+
+      if (tabptr->at_dev != dev ||
+          !net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) ||
+          clock_systime_ticks() - tabptr->at_time > ARP_MAXAGE_TICK)
         {
-          return tabptr;
+          continue;
         }
-    }
 
-  /* Not found */
+      /* Addresses that have failed to be searched will return a special
+       * error code so that the upper layer can return faster.
+       */
 
-  return NULL;
+      if (memcmp(&tabptr->at_ethaddr, &g_zero_ethaddr,
+                 sizeof(tabptr->at_ethaddr)) == 0)
+        {
+          return -ENETUNREACH;
+        }
+
+      /* Yes.. return the Ethernet MAC address if the caller has provided a
+       * non-NULL address in 'ethaddr'.
+       */
+
+      if (ethaddr != NULL)
+        {
+          memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
+        }
+
+      return OK;
+    }
+
+  return -ENOENT;
 }
 
 /****************************************************************************
@@ -276,45 +410,41 @@ static void arp_get_arpreq(FAR struct arpreq *output,
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR const uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_node_s *node;
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
-  bool found = false;
   bool new_entry;
 #endif
-  int i;
+  bool found = false;
+  bool evict = false;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update.  If none is found, the IP -> MAC
+   * address mapping is inserted in a free entry or, if there is none, in
+   * the least recently updated entry.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  node = arp_findnode(ipaddr, dev);
+  if (node != NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_dev == dev &&
-          g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
-        {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-#ifdef CONFIG_NETLINK_ROUTE
-          found = true;
-#endif
-          break;
-        }
-      else
-        {
-          /* Record the oldest entry. */
-
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      found = true;
+    }
+  else if (g_arpfree != NULL)
+    {
+      node      = g_arpfree;
+      g_arpfree = node->an_hnext;
+    }
+  else if (g_arpnused < CONFIG_NET_ARPTAB_SIZE)
+    {
+      node = &g_arptable[g_arpnused++];
+    }
+  else
+    {
+      node  = container_of(dq_peek(&g_arplru), struct arp_node_s, an_lru);
+      evict = true;
     }
 
+  tabptr = &node->an_entry;
   if (ethaddr == NULL)
     {
       ethaddr = g_zero_ethaddr.ether_addr_octet;
@@ -323,7 +453,7 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
   /* When overwite old entry, notify old entry RTM_DELNEIGH */
 
 #ifdef CONFIG_NETLINK_ROUTE
-  if (!found && tabptr->at_ipaddr != 0)
+  if (evict)
     {
       arp_get_arpreq(&arp_notify, tabptr);
       netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
@@ -336,14 +466,28 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
 #endif
 
   /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
+   * information.  A recycled entry moves to the chain of its new address
+   * and every updated entry becomes the most recently updated one.
    */
 
+  write_seqbegin(&g_arpseq);
+
+  if (found || evict)
+    {
+      arp_unlink(node);
+    }
+
   tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
   tabptr->at_dev = dev;
   tabptr->at_time = clock_systime_ticks();
 
+  node->an_hnext = *arp_bucket(ipaddr);
+  *arp_bucket(ipaddr) = node;
+  dq_addlast(&node->an_lru, &g_arplru);
+
+  write_seqend(&g_arpseq);
+
   /* Notify the new entry */
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -404,45 +548,34 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *   dev     - Device structure
  *
  * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ *   The network need not be locked.
  *
  ****************************************************************************/
 
 int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
              FAR struct net_driver_s *dev)
 {
-  FAR struct arp_entry_s *tabptr;
   struct arp_table_info_s info;
+  unsigned int seq;
+  int ret;
 
-  /* Check if the IPv4 address is already in the ARP table. */
+  /* Check if the IPv4 address is already in the ARP table.  This normally
+   * does not need the network lock; only if the table changed while it
+   * was being read is the lookup repeated with the network locked.
+   */
 
-  tabptr = arp_lookup(ipaddr, dev);
-  if (tabptr != NULL)
+  seq = read_seqbegin(&g_arpseq);
+  ret = arp_find_table(ipaddr, ethaddr, dev);
+  if (read_seqretry(&g_arpseq, seq))
     {
-      /* Addresses that have failed to be searched will return a special
-       * error code so that the upper layer can return faster.
-       */
-
-      if (memcmp(&tabptr->at_ethaddr, &g_zero_ethaddr,
-                 sizeof(tabptr->at_ethaddr)) == 0)
-        {
-          return -ENETUNREACH;
-        }
-
-      /* Yes.. return the Ethernet MAC address if the caller has provided a
-       * non-NULL address in 'ethaddr'.
-       */
-
-      if (ethaddr != NULL)
-        {
-          memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
-        }
-
-      /* Return success meaning that a valid Ethernet MAC address mapping
-       * is available for the IP address.
-       */
+      net_lock();
+      ret = arp_find_table(ipaddr, ethaddr, dev);
+      net_unlock();
+    }
 
-      return OK;
+  if (ret != -ENOENT)
+    {
+      return ret;
     }
 
   /* No.. check if the IPv4 address is the address assigned to a local
@@ -453,7 +586,11 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
   info.ai_ipaddr  = ipaddr;
   info.ai_ethaddr = ethaddr;
 
-  if (netdev_foreach(arp_match, &info) != 0)
+  net_lock();
+  ret = netdev_foreach(arp_match, &info);
+  net_unlock();
+
+  if (ret != 0)
     {
       return OK;
     }
@@ -480,25 +617,27 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
 
 int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_node_s *node;
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
 #endif
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr, dev);
-  if (tabptr != NULL)
+  node = arp_lookup(ipaddr, dev);
+  if (node != NULL)
     {
       /* Notify to netlink */
 
 #ifdef CONFIG_NETLINK_ROUTE
-      arp_get_arpreq(&arp_notify, tabptr);
+      arp_get_arpreq(&arp_notify, &node->an_entry);
       netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
 #endif
 
       /* Yes.. Set the IP address to zero to "delete" it */
 
-      tabptr->at_ipaddr = 0;
+      write_seqbegin(&g_arpseq);
+      arp_release(node);
+      write_seqend(&g_arpseq);
       return OK;
     }
 
@@ -521,15 +660,26 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  FAR struct arp_node_s *node;
+  unsigned int i;
+
+  write_seqbegin(&g_arpseq);
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (i = 0; i < g_arpnused; ++i)
     {
-      if (dev == g_arptable[i].at_dev)
+      node = &g_arptable[i];
+      if (dev == node->an_entry.at_dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          if (node->an_entry.at_ipaddr != 0)
+            {
+              arp_release(node);
+            }
+
+          memset(&node->an_entry, 0, sizeof(node->an_entry));
         }
     }
+
+  write_seqend(&g_arpseq);
 }
 
 /****************************************************************************
@@ -567,7 +717,7 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
     {
-      tabptr = &g_arptable[i];
+      tabptr = &g_arptable[i].an_entry;
       if (tabptr->at_ipaddr != 0 &&
           now - tabptr->at_time <= ARP_MAXAGE_TICK)
         {
@@ -32,6 +32,7 @@
 #include <sys/types.h>
 #include <poll.h>
 
+#include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/can.h>
 #include <nuttx/net/net.h>
@@ -57,6 +58,10 @@
 #define can_callback_free(dev,conn,cb) \
   devif_conn_callback_free(dev, cb, &conn->sconn.list, &conn->sconn.list_tail)
 
+/* Number of hash buckets of the exact ID CAN_RAW filters */
+
+#define CAN_FILTER_NHASH 16
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -71,6 +76,18 @@ struct can_poll_s
   FAR struct devif_callback_s *cb; /* Needed to teardown the poll */
 };
 
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+/* A group of CAN_RAW filters sharing the same mask, see can_filter.c */
+
+struct can_fgroup_s
+{
+  canid_t mask;                      /* The mask shared by the group */
+  bool    inv;                       /* CAN_INV_FILTER filters */
+  uint8_t start;                     /* First member in fvalue[] */
+  uint8_t count;                     /* Number of members */
+};
+#endif
+
 /* This "connection" structure describes the underlying state of the socket */
 
 struct can_conn_s
@@ -85,9 +102,13 @@ struct can_conn_s
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
    *               where the CAN/IP read-ahead data is retained.
+   *   rdlock    - Protects readahead, so that recvmsg() can consume frames
+   *               that are already queued without the network lock.  Lock
+   *               order is network lock first, then rdlock.
    */
 
   struct iob_queue_s readahead;      /* remove Read-ahead buffering */
+  mutex_t rdlock;                    /* Protects readahead */
 
 #if CONFIG_NET_RECV_BUFSIZE > 0
   int32_t recv_buffnum;              /* Recv buffer number */
@@ -109,6 +130,21 @@ struct can_conn_s
 #  ifdef CONFIG_NET_CAN_ERRORS
   can_err_mask_t err_mask;
 #  endif
+
+  /* The filters compiled by can_filter_compile() and evaluated by
+   * can_input() before the frame is copied into any IOB.
+   */
+
+  uint8_t fexact;                    /* Number of exact ID filters */
+  uint8_t fngroups;                  /* Number of mask groups */
+  uint8_t fhash[CAN_FILTER_NHASH];   /* Exact ID chains, 1-based */
+  uint8_t fnext[CONFIG_NET_CAN_RAW_FILTER_MAX];
+  canid_t fvalue[CONFIG_NET_CAN_RAW_FILTER_MAX];
+  struct can_fgroup_s fgroups[CONFIG_NET_CAN_RAW_FILTER_MAX];
+
+  bool    rx_match;                  /* Current input frame accepted */
+  uint32_t rx_accepted;              /* Frames accepted by the filters */
+  uint32_t rx_dropped;               /* Frames dropped by the filters */
 #endif
 };
 
@@ -331,6 +367,27 @@ int psock_can_cansend(FAR struct socket *psock);
 ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
                     int flags);
 
+/****************************************************************************
+ * Name: can_sendmmsg
+ *
+ * Description:
+ *   Send a burst of CAN frames with a single callback and a single wait.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   msgvec   The frames (and optional CMSGs) to send
+ *   vlen     The number of entries in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   The number of frames sent.  On error, and only if no frame could be
+ *   sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int can_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: can_readahead_signal
  *
@@ -356,6 +413,45 @@ ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 void can_readahead_signal(FAR struct can_conn_s *conn);
 #endif
 
+/****************************************************************************
+ * Name: can_filter_compile
+ *
+ * Description:
+ *   Compile the CAN_RAW filters of the connection into the exact ID hash
+ *   table and the mask groups evaluated by can_filter_match().
+ *
+ * Input Parameters:
+ *   conn - The CAN connection whose filters changed
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+void can_filter_compile(FAR struct can_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check the ID of a received frame against the compiled filters of the
+ *   connection.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *   id   - The can_id of the received frame
+ *
+ * Returned Value:
+ *   true if the connection wants the frame.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id);
+#endif
+
 /****************************************************************************
  * Name: can_setsockopt
  *
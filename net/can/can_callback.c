@@ -203,6 +203,8 @@ uint16_t can_datahandler(FAR struct net_driver_s *dev,
   FAR struct iob_s *iob = dev->d_iob;
   int ret = 0;
 
+  nxmutex_lock(&conn->rdlock);
+
 #if CONFIG_NET_RECV_BUFSIZE > 0
   /* Check the frame count pending on conn->readahead */
 
@@ -211,6 +213,7 @@ uint16_t can_datahandler(FAR struct net_driver_s *dev,
       nwarn("WARNNING: There are no free recive buffer to retain the data. "
             "Recive buffer number:%"PRId32", recived frames:%"PRIuPTR" \n",
             conn->recv_buffnum, iob_get_queue_entry_count(&conn->readahead));
+      nxmutex_unlock(&conn->rdlock);
       goto errout;
     }
 #endif
@@ -218,6 +221,8 @@ uint16_t can_datahandler(FAR struct net_driver_s *dev,
   /* Concat the iob to readahead */
 
   ret = iob_tryadd_queue(iob, &conn->readahead);
+  nxmutex_unlock(&conn->rdlock);
+
   if (ret >= 0)
     {
 #ifdef CONFIG_NET_CAN_NOTIFIER
@@ -136,6 +136,8 @@ FAR struct can_conn_s *can_alloc(void)
   conn = (FAR struct can_conn_s *)dq_remfirst(&g_free_can_connections);
   if (conn != NULL)
     {
+      nxmutex_init(&conn->rdlock);
+
       /* FIXME SocketCAN default behavior enables loopback */
 
 #ifdef CONFIG_NET_CANPROTO_OPTIONS
@@ -152,6 +154,7 @@ FAR struct can_conn_s *can_alloc(void)
        */
 
       conn->filter_count = 1;
+      can_filter_compile(conn);
 #endif
 
       /* Enqueue the connection into the active list */
@@ -183,6 +186,7 @@ void can_free(FAR struct can_conn_s *conn)
   /* Remove the connection from the active list */
 
   dq_rem(&conn->sconn.node, &g_active_can_connections);
+  nxmutex_destroy(&conn->rdlock);
 
   /* If this is a preallocated or a batch allocated connection store it in
    * the free connections list. Else free it.
@@ -0,0 +1,232 @@
+/****************************************************************************
+ * net/can/can_filter.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_CAN) && \
+    defined(CONFIG_NET_CANPROTO_OPTIONS)
+
+#include <stdbool.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/can.h>
+
+#include "can/can.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All the bits of a frame ID that an exact filter must cover */
+
+#define CAN_FILTER_FULLMASK(id) \
+  (CAN_EFF_FLAG | CAN_RTR_FLAG | \
+   (((id) & CAN_EFF_FLAG) != 0 ? CAN_EFF_MASK : CAN_SFF_MASK))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline unsigned int can_filter_hash(canid_t id)
+{
+  id ^= id >> 16;
+  id ^= id >> 8;
+  id ^= id >> 4;
+  return id & (CAN_FILTER_NHASH - 1);
+}
+
+static inline bool can_filter_isexact(FAR const struct can_filter *filter)
+{
+  canid_t fullmask = CAN_FILTER_FULLMASK(filter->can_id);
+
+  return (filter->can_id & CAN_INV_FILTER) == 0 &&
+         (filter->can_mask & fullmask) == fullmask &&
+         (filter->can_id & filter->can_mask & ~fullmask) == 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: can_filter_compile
+ *
+ * Description:
+ *   Compile conn->filters[] into the lookup form used by can_filter_match:
+ *   the exact ID filters are chained into a small hash table, the other
+ *   filters are grouped by mask (and inversion) so that every group costs
+ *   a single AND of the received ID.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection whose filters changed
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void can_filter_compile(FAR struct can_conn_s *conn)
+{
+  FAR const struct can_filter *filter;
+  FAR struct can_fgroup_s *group;
+  uint8_t nvalue = 0;
+  int i;
+  int j;
+
+  conn->fexact   = 0;
+  conn->fngroups = 0;
+  memset(conn->fhash, 0, sizeof(conn->fhash));
+
+  /* Exact ID filters first, they occupy the head of fvalue[] */
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      filter = &conn->filters[i];
+      if (can_filter_isexact(filter))
+        {
+          canid_t key = filter->can_id & CAN_FILTER_FULLMASK(filter->can_id);
+          unsigned int hash = can_filter_hash(key);
+
+          conn->fvalue[nvalue] = key;
+          conn->fnext[nvalue]  = conn->fhash[hash];
+          conn->fhash[hash]    = ++nvalue;
+        }
+    }
+
+  conn->fexact = nvalue;
+
+  /* Then the mask groups, the members of a group are adjacent in
+   * fvalue[] and store the ID already masked.
+   */
+
+  for (i = 0; i < conn->filter_count; i++)
+    {
+      canid_t mask;
+      bool inv;
+
+      filter = &conn->filters[i];
+      if (can_filter_isexact(filter))
+        {
+          continue;
+        }
+
+      mask = filter->can_mask;
+      inv  = (filter->can_id & CAN_INV_FILTER) != 0;
+
+      for (j = 0; j < conn->fngroups; j++)
+        {
+          if (conn->fgroups[j].mask == mask && conn->fgroups[j].inv == inv)
+            {
+              break;
+            }
+        }
+
+      if (j < conn->fngroups)
+        {
+          continue; /* This group was already emitted */
+        }
+
+      group        = &conn->fgroups[conn->fngroups++];
+      group->mask  = mask;
+      group->inv   = inv;
+      group->start = nvalue;
+
+      for (j = i; j < conn->filter_count; j++)
+        {
+          FAR const struct can_filter *member = &conn->filters[j];
+
+          if (!can_filter_isexact(member) && member->can_mask == mask &&
+              ((member->can_id & CAN_INV_FILTER) != 0) == inv)
+            {
+              conn->fvalue[nvalue++] = member->can_id & ~CAN_INV_FILTER &
+                                       mask;
+            }
+        }
+
+      group->count = nvalue - group->start;
+    }
+}
+
+/****************************************************************************
+ * Name: can_filter_match
+ *
+ * Description:
+ *   Check the ID of a received frame against the compiled filters of the
+ *   connection.
+ *
+ * Input Parameters:
+ *   conn - The CAN connection
+ *   id   - The can_id of the received frame
+ *
+ * Returned Value:
+ *   true if the connection wants the frame.
+ *
+ ****************************************************************************/
+
+bool can_filter_match(FAR struct can_conn_s *conn, canid_t id)
+{
+  FAR const struct can_fgroup_s *group;
+  canid_t key;
+  int i;
+  int j;
+
+#ifdef CONFIG_NET_CAN_ERRORS
+  /* error message frame */
+
+  if ((id & CAN_ERR_FLAG) != 0)
+    {
+      return (id & conn->err_mask) != 0;
+    }
+#endif
+
+  key = id & CAN_FILTER_FULLMASK(id);
+  for (i = conn->fhash[can_filter_hash(key)]; i != 0;
+       i = conn->fnext[i - 1])
+    {
+      if (conn->fvalue[i - 1] == key)
+        {
+          return true;
+        }
+    }
+
+  for (i = 0; i < conn->fngroups; i++)
+    {
+      group = &conn->fgroups[i];
+      key   = id & group->mask;
+
+      for (j = group->start; j < group->start + group->count; j++)
+        {
+          if ((conn->fvalue[j] == key) != group->inv)
+            {
+              return true;
+            }
+        }
+    }
+
+  return false;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_CAN && CONFIG_NET_CANPROTO_OPTIONS */
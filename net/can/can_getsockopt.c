@@ -142,6 +142,22 @@ int can_getsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+      case CAN_RAW_FILTER_STATS:
+        if (*value_len < sizeof(struct can_filter_stats))
+          {
+            return -EINVAL;
+          }
+        else
+          {
+            FAR struct can_filter_stats *stats =
+              (FAR struct can_filter_stats *)value;
+
+            stats->accepted = conn->rx_accepted;
+            stats->dropped  = conn->rx_dropped;
+            *value_len      = sizeof(struct can_filter_stats);
+          }
+        break;
+
       case CAN_RAW_LOOPBACK:
       case CAN_RAW_RECV_OWN_MSGS:
 #ifdef CONFIG_NET_CAN_CANFD
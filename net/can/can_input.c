@@ -28,6 +28,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_CAN)
 
 #include <errno.h>
+#include <string.h>
 #include <debug.h>
 
 #include <nuttx/net/netdev.h>
@@ -132,6 +133,72 @@ const uint8_t g_len_to_can_dlc[65] =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: can_input_filter
+ *
+ * Description:
+ *   Run the received frame through the compiled filters of every
+ *   connection bound to the device, remember the verdict in the connection
+ *   and update its accept/drop counters.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure containing the received packet
+ *
+ * Returned Value:
+ *   true if at least one connection accepted the frame.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+static bool can_input_filter(FAR struct net_driver_s *dev)
+{
+  FAR struct can_conn_s *conn = NULL;
+  bool accepted = false;
+  canid_t can_id;
+
+  memcpy(&can_id, dev->d_buf, sizeof(canid_t));
+
+  while ((conn = can_active(dev, conn)) != NULL)
+    {
+      conn->rx_match = can_filter_match(conn, can_id);
+      if (conn->rx_match)
+        {
+          conn->rx_accepted++;
+          accepted = true;
+        }
+      else
+        {
+          conn->rx_dropped++;
+        }
+    }
+
+  return accepted;
+}
+
+/****************************************************************************
+ * Name: can_nextmatch
+ *
+ * Description:
+ *   Like can_active(), but skip the connections whose filters rejected the
+ *   current frame in can_input_filter().
+ *
+ ****************************************************************************/
+
+static FAR struct can_conn_s *can_nextmatch(FAR struct net_driver_s *dev,
+                                            FAR struct can_conn_s *conn)
+{
+  do
+    {
+      conn = can_active(dev, conn);
+    }
+  while (conn != NULL && !conn->rx_match);
+
+  return conn;
+}
+#else
+#  define can_nextmatch(dev, conn) can_active(dev, conn)
+#endif
+
 /****************************************************************************
  * Name: can_input_conn
  *
@@ -215,12 +282,12 @@ static int can_input_conn(FAR struct net_driver_s *dev,
 
 static int can_in(FAR struct net_driver_s *dev)
 {
-  FAR struct can_conn_s *conn = can_active(dev, NULL);
+  FAR struct can_conn_s *conn = can_nextmatch(dev, NULL);
   FAR struct can_conn_s *nextconn;
 
   /* Do we have second connection that can hold this packet? */
 
-  while ((nextconn = can_active(dev, conn)) != NULL)
+  while ((nextconn = can_nextmatch(dev, conn)) != NULL)
     {
       /* Yes... There are multiple listeners on the same dev.
        * We need to clone the packet and deliver it to each listener.
@@ -277,13 +344,36 @@ int can_input(FAR struct net_driver_s *dev)
       /* Set the device buffer to l2 */
 
       dev->d_buf = NETLLBUF;
-      ret = can_in(dev);
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+      if (!can_input_filter(dev))
+        {
+          /* No socket wants this frame, drop it before it is cloned */
+
+          netdev_iob_release(dev);
+          ret = OK;
+        }
+      else
+#endif
+        {
+          ret = can_in(dev);
+        }
 
       dev->d_buf = buf;
 
       return ret;
     }
 
+#ifdef CONFIG_NET_CANPROTO_OPTIONS
+  /* Filter the frame while it is still in the driver buffer, so that a
+   * rejected frame never consumes an IOB.
+   */
+
+  if (!can_input_filter(dev))
+    {
+      return OK;
+    }
+#endif
+
   return netdev_input(dev, can_in, false);
 }
 
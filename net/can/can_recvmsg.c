@@ -74,10 +74,6 @@ struct can_recvfrom_s
  * Private Functions
  ****************************************************************************/
 
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-static int can_recv_filter(FAR struct can_conn_s *conn, canid_t id);
-#endif
-
 /****************************************************************************
  * Name: can_add_recvlen
  *
@@ -217,10 +213,10 @@ static inline void can_newdata(FAR struct net_driver_s *dev,
  *   pstate   recvfrom state structure
  *
  * Returned Value:
- *   None
+ *   The number of bytes received, zero if nothing was received.
  *
  * Assumptions:
- *   The network is locked.
+ *   Takes conn->rdlock, the network does not need to be locked.
  *
  ****************************************************************************/
 
@@ -228,7 +224,7 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
 {
   FAR struct can_conn_s *conn = pstate->pr_conn;
   FAR struct iob_s *iob;
-  int recvlen;
+  int recvlen = 0;
 
   /* Check there is any CAN data already buffered in a read-ahead
    * buffer.
@@ -236,36 +232,12 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
 
   pstate->pr_recvlen = -1;
 
+  nxmutex_lock(&conn->rdlock);
   if ((iob = iob_peek_queue(&conn->readahead)) != NULL &&
       pstate->pr_buflen > 0)
     {
       DEBUGASSERT(iob->io_pktlen > 0);
 
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-      /* Check receive filters */
-
-      canid_t can_id;
-      iob_copyout((uint8_t *)&can_id, iob, sizeof(canid_t), 0);
-
-      if (can_recv_filter(conn, can_id) == 0)
-        {
-          FAR struct iob_s *tmp;
-
-          /* Remove the I/O buffer chain from the head of the read-ahead
-           * buffer queue.
-           */
-
-          tmp = iob_remove_queue(&conn->readahead);
-          DEBUGASSERT(tmp == iob);
-          UNUSED(tmp);
-
-          /* And free the I/O buffer chain */
-
-          iob_free_chain(iob);
-          return 0;
-        }
-#endif
-
 #ifdef CONFIG_NET_TIMESTAMP
       if (_SO_GETOPT(conn->sconn.s_options, SO_TIMESTAMP) &&
           pstate->pr_msglen == sizeof(struct timeval))
@@ -320,54 +292,14 @@ static inline int can_readahead(struct can_recvfrom_s *pstate)
         {
           if (recvlen > sizeof(struct can_frame))
             {
-              return 0;
-            }
-        }
-
-      return recvlen;
-    }
-
-  return 0;
-}
-
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-static int can_recv_filter(FAR struct can_conn_s *conn, canid_t id)
-{
-  uint32_t i;
-
-#ifdef CONFIG_NET_CAN_ERRORS
-  /* error message frame */
-
-  if ((id & CAN_ERR_FLAG) != 0)
-    {
-      return id & conn->err_mask ? 1 : 0;
-    }
-#endif
-
-  for (i = 0; i < conn->filter_count; i++)
-    {
-      if (conn->filters[i].can_id & CAN_INV_FILTER)
-        {
-          if ((id & conn->filters[i].can_mask) !=
-                ((conn->filters[i].can_id & ~CAN_INV_FILTER) &
-                 conn->filters[i].can_mask))
-            {
-              return 1;
-            }
-        }
-      else
-        {
-          if ((id & conn->filters[i].can_mask) ==
-                (conn->filters[i].can_id & conn->filters[i].can_mask))
-            {
-              return 1;
+              recvlen = 0;
             }
         }
     }
 
-  return 0;
+  nxmutex_unlock(&conn->rdlock);
+  return recvlen;
 }
-#endif
 
 static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
                                           FAR void *pvpriv, uint16_t flags)
@@ -378,25 +310,16 @@ static uint16_t can_recvfrom_eventhandler(FAR struct net_driver_s *dev,
 
   if (pstate)
     {
-#if defined(CONFIG_NET_CANPROTO_OPTIONS) || defined(CONFIG_NET_TIMESTAMP)
+#if (defined(CONFIG_NET_CANPROTO_OPTIONS) && \
+     defined(CONFIG_NET_CAN_CANFD)) || defined(CONFIG_NET_TIMESTAMP)
       struct can_conn_s *conn = pstate->pr_conn;
 #endif
 
       if ((flags & CAN_NEWDATA) != 0)
         {
-          /* If a new packet is available, check receive filters
-           * when is valid then complete the read action.
+          /* If a new packet is available, complete the read action.  The
+           * receive filters were already applied by can_input().
            */
-#ifdef CONFIG_NET_CANPROTO_OPTIONS
-          canid_t can_id;
-          memcpy(&can_id, dev->d_appdata, sizeof(canid_t));
-
-          if (can_recv_filter(conn, can_id) == 0)
-            {
-              flags &= ~CAN_NEWDATA;
-              return flags;
-            }
-#endif
 
           /* do not pass frames with DLC > 8 to a legacy socket */
 #if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
@@ -526,8 +449,6 @@ ssize_t can_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENOSYS;
     }
 
-  net_lock();
-
   /* Initialize the state structure. */
 
   memset(&state, 0, sizeof(struct can_recvfrom_s));
@@ -552,7 +473,8 @@ ssize_t can_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Handle any any CAN data already buffered in a read-ahead buffer.  NOTE
    * that there may be read-ahead data to be retrieved even after the
-   * socket has been disconnected.
+   * socket has been disconnected.  This only takes the lock of the
+   * read-ahead queue, not the network lock.
    */
 
   ret = can_readahead(&state);
@@ -580,13 +502,26 @@ ssize_t can_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
         }
     }
 
+  /* Lock the network so that no input is processed until the callback is
+   * in place, and look again in case a frame was queued before the lock
+   * was taken.
+   */
+
+  net_lock();
+
+  ret = can_readahead(&state);
+  if (ret > 0)
+    {
+      goto errout_with_lock;
+    }
+
   /* Get the device driver that will service this transfer */
 
   dev = conn->dev;
   if (dev == NULL)
     {
       ret = -ENODEV;
-      goto errout_with_state;
+      goto errout_with_lock;
     }
 
   /* Set up the callback in the connection */
@@ -616,8 +551,10 @@ ssize_t can_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       ret = -EBUSY;
     }
 
-errout_with_state:
+errout_with_lock:
   net_unlock();
+
+errout_with_state:
   nxsem_destroy(&state.pr_sem);
   return ret;
 }
@@ -67,12 +67,82 @@ struct send_s
   size_t                  pr_msglen;   /* Length of msg buffer */
   FAR uint8_t            *pr_msgbuf;   /* Pointer to msg buffer */
   ssize_t                 snd_sent;    /* The number of bytes sent */
+  FAR struct can_conn_s  *snd_conn;    /* The sending connection */
+  FAR struct mmsghdr     *snd_msgvec;  /* Frames of a sendmmsg() burst */
+  unsigned int            snd_vlen;    /* Number of frames in the burst */
+  unsigned int            snd_nsent;   /* Number of frames already sent */
 };
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: can_sendmsg_check
+ *
+ * Description:
+ *   Verify that a message holds exactly one CAN (or CAN FD) frame.
+ *
+ ****************************************************************************/
+
+static int can_sendmsg_check(FAR struct can_conn_s *conn,
+                             FAR struct msghdr *msg)
+{
+#if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
+  if (_SO_GETOPT(conn->sconn.s_options, CAN_RAW_FD_FRAMES))
+    {
+      if (msg->msg_iov->iov_len != CANFD_MTU &&
+          msg->msg_iov->iov_len != CAN_MTU)
+        {
+          return -EINVAL;
+        }
+    }
+  else
+#endif
+    {
+      if (msg->msg_iov->iov_len != CAN_MTU)
+        {
+          return -EINVAL;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: can_sendmsg_setup
+ *
+ * Description:
+ *   Point the send state at the frame (and the optional TX deadline) of the
+ *   next message to send.
+ *
+ ****************************************************************************/
+
+static void can_sendmsg_setup(FAR struct can_conn_s *conn,
+                              FAR struct send_s *pstate,
+                              FAR struct msghdr *msg)
+{
+  pstate->snd_buflen = msg->msg_iov->iov_len;  /* bytes to send */
+  pstate->snd_buffer = msg->msg_iov->iov_base; /* Buffer to send from */
+  pstate->pr_msgbuf  = NULL;
+  pstate->pr_msglen  = 0;
+
+#ifdef CONFIG_NET_CAN_RAW_TX_DEADLINE
+  if (msg->msg_controllen > sizeof(struct cmsghdr))
+    {
+      FAR struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg);
+      if (_SO_GETOPT(conn->sconn.s_options, CAN_RAW_TX_DEADLINE) &&
+          cmsg->cmsg_level == SOL_CAN_RAW &&
+          cmsg->cmsg_type == CAN_RAW_TX_DEADLINE &&
+          cmsg->cmsg_len == sizeof(struct timeval))
+        {
+          pstate->pr_msgbuf = CMSG_DATA(cmsg); /* Buffer to cmsg data */
+          pstate->pr_msglen = cmsg->cmsg_len;  /* len of cmsg data */
+        }
+    }
+#endif
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  ****************************************************************************/
@@ -123,6 +193,25 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               memcpy(dev->d_buf + pstate->snd_buflen, pstate->pr_msgbuf,
                      pstate->pr_msglen);
             }
+
+          /* If this is a sendmmsg() burst, queue up the next frame for the
+           * next polling cycle instead of waking the sender for each one.
+           */
+
+          if (pstate->snd_msgvec != NULL)
+            {
+              FAR struct mmsghdr *mmsg =
+                &pstate->snd_msgvec[pstate->snd_nsent];
+
+              mmsg->msg_len = pstate->snd_sent;
+              if (++pstate->snd_nsent < pstate->snd_vlen)
+                {
+                  can_sendmsg_setup(pstate->snd_conn, pstate,
+                                    &mmsg[1].msg_hdr);
+                  netdev_txnotify_dev(dev);
+                  return flags;
+                }
+            }
         }
 
 end_wait:
@@ -141,6 +230,60 @@ end_wait:
   return flags;
 }
 
+/****************************************************************************
+ * Name: can_send_wait
+ *
+ * Description:
+ *   Arm the send callback, kick the driver and wait until the event handler
+ *   has sent everything described by the send state or an error occurred.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int can_send_wait(FAR struct net_driver_s *dev,
+                         FAR struct can_conn_s *conn,
+                         FAR struct send_s *pstate, int flags)
+{
+  int ret = OK;
+
+  /* Allocate resource to receive a callback */
+
+  pstate->snd_cb = can_callback_alloc(dev, conn);
+  if (pstate->snd_cb)
+    {
+      /* Set up the callback in the connection */
+
+      pstate->snd_cb->flags = CAN_POLL;
+      pstate->snd_cb->priv  = pstate;
+      pstate->snd_cb->event = psock_send_eventhandler;
+
+      /* Notify the device driver that new TX data is available. */
+
+      netdev_txnotify_dev(dev);
+
+      /* Wait for the send to complete or an error to occur.
+       * net_sem_timedwait will also terminate if a signal is received.
+       */
+
+      if (_SS_ISNONBLOCK(conn->sconn.s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          ret = net_sem_timedwait(&pstate->snd_sem, 0);
+        }
+      else
+        {
+          ret = net_sem_timedwait(&pstate->snd_sem, UINT_MAX);
+        }
+
+      /* Make sure that no further events are processed */
+
+      can_callback_free(dev, conn, pstate->snd_cb);
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -200,22 +343,10 @@ ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
       return -ENODEV;
     }
 
-#if defined(CONFIG_NET_CANPROTO_OPTIONS) && defined(CONFIG_NET_CAN_CANFD)
-  if (_SO_GETOPT(conn->sconn.s_options, CAN_RAW_FD_FRAMES))
-    {
-      if (msg->msg_iov->iov_len != CANFD_MTU &&
-          msg->msg_iov->iov_len != CAN_MTU)
-        {
-          return -EINVAL;
-        }
-    }
-  else
-#endif
+  ret = can_sendmsg_check(conn, msg);
+  if (ret < 0)
     {
-      if (msg->msg_iov->iov_len != CAN_MTU)
-        {
-          return -EINVAL;
-        }
+      return ret;
     }
 
   /* Perform the send operation */
@@ -228,56 +359,9 @@ ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   memset(&state, 0, sizeof(struct send_s));
   nxsem_init(&state.snd_sem, 0, 0); /* Doesn't really fail */
 
-  state.snd_buflen = msg->msg_iov->iov_len;  /* bytes to send */
-  state.snd_buffer = msg->msg_iov->iov_base; /* Buffer to send from */
-
-#ifdef CONFIG_NET_CAN_RAW_TX_DEADLINE
-  if (msg->msg_controllen > sizeof(struct cmsghdr))
-    {
-      FAR struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg);
-      if (_SO_GETOPT(conn->sconn.s_options, CAN_RAW_TX_DEADLINE) &&
-          cmsg->cmsg_level == SOL_CAN_RAW &&
-          cmsg->cmsg_type == CAN_RAW_TX_DEADLINE &&
-          cmsg->cmsg_len == sizeof(struct timeval))
-        {
-          state.pr_msgbuf = CMSG_DATA(cmsg); /* Buffer to cmsg data */
-          state.pr_msglen = cmsg->cmsg_len;  /* len of cmsg data */
-        }
-    }
-#endif
-
-  /* Allocate resource to receive a callback */
-
-  state.snd_cb = can_callback_alloc(dev, conn);
-  if (state.snd_cb)
-    {
-      /* Set up the callback in the connection */
-
-      state.snd_cb->flags = CAN_POLL;
-      state.snd_cb->priv  = (FAR void *)&state;
-      state.snd_cb->event = psock_send_eventhandler;
-
-      /* Notify the device driver that new TX data is available. */
-
-      netdev_txnotify_dev(dev);
-
-      /* Wait for the send to complete or an error to occur.
-       * net_sem_timedwait will also terminate if a signal is received.
-       */
-
-      if (_SS_ISNONBLOCK(conn->sconn.s_flags) || (flags & MSG_DONTWAIT) != 0)
-        {
-          ret = net_sem_timedwait(&state.snd_sem, 0);
-        }
-      else
-        {
-          ret = net_sem_timedwait(&state.snd_sem, UINT_MAX);
-        }
-
-      /* Make sure that no further events are processed */
+  can_sendmsg_setup(conn, &state, msg);
 
-      can_callback_free(dev, conn, state.snd_cb);
-    }
+  ret = can_send_wait(dev, conn, &state, flags);
 
   nxsem_destroy(&state.snd_sem);
   net_unlock();
@@ -306,6 +390,97 @@ ssize_t can_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   return state.snd_sent;
 }
 
+/****************************************************************************
+ * Name: can_sendmmsg
+ *
+ * Description:
+ *   Send a burst of CAN frames.  The whole burst is served by a single
+ *   callback that sends one frame per polling cycle, so the sender is only
+ *   woken up once when the last frame has gone out.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   msgvec   The frames (and optional CMSGs) to send
+ *   vlen     The number of entries in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   The number of frames sent.  On error, and only if no frame could be
+ *   sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int can_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                 unsigned int vlen, int flags)
+{
+  FAR struct net_driver_s *dev;
+  FAR struct can_conn_s *conn;
+  struct send_s state;
+  unsigned int i;
+  int ret;
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_RAW)
+    {
+      return -EDESTADDRREQ;
+    }
+
+  conn = psock->s_conn;
+  dev  = conn->dev;
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  /* Only send the leading run of well-formed frames */
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = can_sendmsg_check(conn, &msgvec[i].msg_hdr);
+      if (ret < 0)
+        {
+          if (i == 0)
+            {
+              return ret;
+            }
+
+          break;
+        }
+    }
+
+  net_lock();
+  memset(&state, 0, sizeof(struct send_s));
+  nxsem_init(&state.snd_sem, 0, 0); /* Doesn't really fail */
+
+  state.snd_conn   = conn;
+  state.snd_msgvec = msgvec;
+  state.snd_vlen   = i;
+  can_sendmsg_setup(conn, &state, &msgvec[0].msg_hdr);
+
+  ret = can_send_wait(dev, conn, &state, flags);
+
+  nxsem_destroy(&state.snd_sem);
+  net_unlock();
+
+  /* A partially sent burst still reports the frames that went out */
+
+  if (state.snd_nsent > 0)
+    {
+      return state.snd_nsent;
+    }
+
+  if (state.snd_sent < 0)
+    {
+      return state.snd_sent;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: psock_can_cansend
  *
@@ -84,7 +84,14 @@ const struct sock_intf_s g_can_sockif =
 #if defined(CONFIG_NET_SOCKOPTS) && defined(CONFIG_NET_CANPROTO_OPTIONS)
   , can_getsockopt  /* si_getsockopt */
   , can_setsockopt  /* si_setsockopt */
+#elif defined(CONFIG_NET_SOCKOPTS)
+  , NULL            /* si_getsockopt */
+  , NULL            /* si_setsockopt */
 #endif
+#ifdef CONFIG_NET_SENDFILE
+  , NULL            /* si_sendfile */
+#endif
+  , can_sendmmsg    /* si_sendmmsg */
 };
 
 /****************************************************************************
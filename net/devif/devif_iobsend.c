@@ -74,7 +74,11 @@ int devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
     }
 
 #ifndef CONFIG_NET_IPFRAG
-  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset)
+  if (len > NETDEV_PKTSIZE(dev) - NET_LL_HDRLEN(dev) - target_offset
+#  ifdef CONFIG_NETDEV_GSO
+      && len > dev->d_gso_maxsize
+#  endif
+     )
     {
       ret = -EMSGSIZE;
       goto errout;
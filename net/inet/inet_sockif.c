@@ -113,6 +113,9 @@ static ssize_t    inet_sendfile(FAR struct socket *psock,
                                 FAR struct file *infile, FAR off_t *offset,
                                 size_t count);
 #endif
+static int        inet_sendmmsg(FAR struct socket *psock,
+                                FAR struct mmsghdr *msgvec,
+                                unsigned int vlen, int flags);
 
 /****************************************************************************
  * Private Data
@@ -143,6 +146,7 @@ static const struct sock_intf_s g_inet_sockif =
 #ifdef CONFIG_NET_SENDFILE
   , inet_sendfile   /* si_sendfile */
 #endif
+  , inet_sendmmsg   /* si_sendmmsg */
 };
 
 /****************************************************************************
@@ -1987,6 +1991,61 @@ static ssize_t inet_sendmsg(FAR struct socket *psock,
   return ret;
 }
 
+/****************************************************************************
+ * Name: inet_sendmmsg
+ *
+ * Description:
+ *   Send a burst of messages.  For datagram sockets the network stays
+ *   locked for the whole burst: buffered UDP only queues each datagram and
+ *   notifies the device when its write queue was empty, so the burst costs
+ *   one lock and one TX notification, and the device starts draining the
+ *   queue once the lock is released.  The send paths release the lock
+ *   through the net_sem_*() helpers whenever they have to wait.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The messages to send, already validated by psock_sendmmsg()
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   The number of messages sent, or a negated errno value if the first
+ *   message could not be sent.
+ *
+ ****************************************************************************/
+
+static int inet_sendmmsg(FAR struct socket *psock,
+                         FAR struct mmsghdr *msgvec,
+                         unsigned int vlen, int flags)
+{
+  bool burst = psock->s_type == SOCK_DGRAM;
+  unsigned int i;
+  ssize_t ret = OK;
+
+  if (burst)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = inet_sendmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+    }
+
+  if (burst)
+    {
+      net_unlock();
+    }
+
+  return i > 0 ? i : ret;
+}
+
 /****************************************************************************
  * Name: inet_ioctl
  *
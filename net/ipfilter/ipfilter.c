@@ -27,6 +27,7 @@
 #include <nuttx/config.h>
 
 #include <debug.h>
+#include <string.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/icmpv6.h>
@@ -65,15 +66,91 @@
 #define IPv6_L4HDR(ipv6, proto) \
   ((FAR void *)(net_ipv6_payload((FAR struct ipv6_hdr_s *)(ipv6), &(proto))))
 
+/* Whether the packet carries TCP/UDP ports that the index can hash on. */
+
+#define IPFILTER_HASPORTS(proto) \
+  ((proto) == IP_PROTO_TCP || (proto) == IP_PROTO_UDP)
+
+#ifndef CONFIG_NET_IPFILTER_HASH_SIZE
+#  define CONFIG_NET_IPFILTER_HASH_SIZE 16
+#endif
+
+#ifndef CONFIG_NET_IPFILTER_FLOWCACHE
+#  define CONFIG_NET_IPFILTER_FLOWCACHE 0
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The compiled form of a chain.  Rules matching a TCP/UDP protocol and a
+ * single destination port are linked into the bucket of that protocol and
+ * port, all other rules are linked into the 'other' list.  Both kinds of
+ * list are kept in chain order through 'inext', so merging a bucket with
+ * the 'other' list by 'seq' visits exactly the candidate rules in the same
+ * order as the original chain.
+ */
+
+struct ipfilter_index_s
+{
+  FAR struct ipfilter_entry_s *bucket[CONFIG_NET_IPFILTER_HASH_SIZE];
+  FAR struct ipfilter_entry_s *other;
+  uint16_t nrules;
+};
+
+/* Accepted flows.  For TCP/UDP the verdict of a chain depends only on the
+ * devices, the addresses, the protocol and the ports, so a cached ACCEPT
+ * stays exact until the rules change.
+ */
+
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+struct ipfilter_flow_s
+{
+  FAR const struct net_driver_s *indev;
+  FAR const struct net_driver_s *outdev;
+  uint16_t sport;
+  uint16_t dport;
+  uint8_t  proto;
+  uint8_t  chain;
+  bool     valid;
+};
+
+#ifdef CONFIG_NET_IPv4
+struct ipv4_filter_flow_s
+{
+  struct ipfilter_flow_s common;
+  in_addr_t sip;
+  in_addr_t dip;
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+struct ipv6_filter_flow_s
+{
+  struct ipfilter_flow_s common;
+  net_ipv6addr_t sip;
+  net_ipv6addr_t dip;
+};
+#endif
+#endif /* CONFIG_NET_IPFILTER_FLOWCACHE > 0 */
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
 static sq_queue_t g_ipv4_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_index_s g_ipv4_index[IPFILTER_CHAIN_MAX];
+#  if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+static struct ipv4_filter_flow_s g_ipv4_flows[CONFIG_NET_IPFILTER_FLOWCACHE];
+#  endif
 #endif
 #ifdef CONFIG_NET_IPv6
 static sq_queue_t g_ipv6_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_index_s g_ipv6_index[IPFILTER_CHAIN_MAX];
+#  if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+static struct ipv6_filter_flow_s g_ipv6_flows[CONFIG_NET_IPFILTER_FLOWCACHE];
+#  endif
 #endif
 
 /****************************************************************************
@@ -188,6 +265,185 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
     }
 }
 
+/****************************************************************************
+ * Name: ipfilter_hash
+ *
+ * Description:
+ *   Return the index bucket of a TCP/UDP protocol and destination port
+ *   (in host order).
+ *
+ ****************************************************************************/
+
+static inline unsigned int ipfilter_hash(uint8_t proto, uint16_t dport)
+{
+  return (proto ^ dport ^ (dport >> 8)) % CONFIG_NET_IPFILTER_HASH_SIZE;
+}
+
+/****************************************************************************
+ * Name: ipfilter_index_add
+ *
+ * Description:
+ *   Compile a new filter entry, appended to the end of its chain, into the
+ *   index of the chain.
+ *
+ * Input Parameters:
+ *   index - The index of the chain
+ *   entry - The filter entry to add
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void ipfilter_index_add(FAR struct ipfilter_index_s *index,
+                               FAR struct ipfilter_entry_s *entry)
+{
+  FAR struct ipfilter_entry_s **tail;
+
+  /* Only a rule that can match nothing but one protocol and one
+   * destination port may be hashed, anything else must be seen by every
+   * packet.
+   */
+
+  if (IPFILTER_HASPORTS(entry->proto) && !entry->inv_proto &&
+      entry->match_tcpudp && !entry->inv_dport &&
+      entry->match.tcpudp.dports[0] == entry->match.tcpudp.dports[1])
+    {
+      tail = &index->bucket[ipfilter_hash(entry->proto,
+                                          entry->match.tcpudp.dports[0])];
+    }
+  else
+    {
+      tail = &index->other;
+    }
+
+  while (*tail != NULL)
+    {
+      tail = &(*tail)->inext;
+    }
+
+  entry->seq   = index->nrules++;
+  entry->inext = NULL;
+  *tail        = entry;
+}
+
+/****************************************************************************
+ * Name: ipfilter_index_next
+ *
+ * Description:
+ *   Return the next candidate entry in chain order from a bucket list and
+ *   the list of unhashed entries, advancing the list it was taken from.
+ *
+ ****************************************************************************/
+
+static FAR const struct ipfilter_entry_s *
+ipfilter_index_next(FAR const struct ipfilter_entry_s **bucket,
+                    FAR const struct ipfilter_entry_s **other)
+{
+  FAR const struct ipfilter_entry_s *entry;
+
+  if (*bucket != NULL && (*other == NULL || (*bucket)->seq < (*other)->seq))
+    {
+      entry   = *bucket;
+      *bucket = entry->inext;
+    }
+  else
+    {
+      entry = *other;
+      if (entry != NULL)
+        {
+          *other = entry->inext;
+        }
+    }
+
+  return entry;
+}
+
+/****************************************************************************
+ * Name: ipv4_filter_flow / ipv6_filter_flow
+ *
+ * Description:
+ *   Return the flow cache slot of a TCP/UDP packet.  Whether the slot
+ *   really holds this flow must still be checked by the caller.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+#ifdef CONFIG_NET_IPv4
+static FAR struct ipv4_filter_flow_s *
+ipv4_filter_flow(in_addr_t sip, in_addr_t dip, uint16_t sport,
+                 uint16_t dport)
+{
+  uint32_t hash = sip ^ dip ^ ((uint32_t)sport << 16 | dport);
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_ipv4_flows[hash % CONFIG_NET_IPFILTER_FLOWCACHE];
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static FAR struct ipv6_filter_flow_s *
+ipv6_filter_flow(FAR const uint16_t *sip, FAR const uint16_t *dip,
+                 uint16_t sport, uint16_t dport)
+{
+  uint32_t hash = (uint32_t)sport << 16 | dport;
+  int i;
+
+  for (i = 0; i < 8; i++)
+    {
+      hash = (hash << 5) + hash + (sip[i] ^ dip[i]);
+    }
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_ipv6_flows[hash % CONFIG_NET_IPFILTER_FLOWCACHE];
+}
+#endif
+
+/****************************************************************************
+ * Name: ipfilter_flow_match
+ *
+ * Description:
+ *   Return true if the common part of a cached flow is the given one.
+ *
+ ****************************************************************************/
+
+static bool ipfilter_flow_match(FAR const struct ipfilter_flow_s *flow,
+                                FAR const struct net_driver_s *indev,
+                                FAR const struct net_driver_s *outdev,
+                                uint8_t proto, uint16_t sport,
+                                uint16_t dport, enum ipfilter_chain_e chain)
+{
+  return flow->valid && flow->indev == indev && flow->outdev == outdev &&
+         flow->proto == proto && flow->sport == sport &&
+         flow->dport == dport && flow->chain == chain;
+}
+
+/****************************************************************************
+ * Name: ipfilter_flow_set
+ *
+ * Description:
+ *   Record the common part of an accepted flow.
+ *
+ ****************************************************************************/
+
+static void ipfilter_flow_set(FAR struct ipfilter_flow_s *flow,
+                              FAR const struct net_driver_s *indev,
+                              FAR const struct net_driver_s *outdev,
+                              uint8_t proto, uint16_t sport,
+                              uint16_t dport, enum ipfilter_chain_e chain)
+{
+  flow->indev  = indev;
+  flow->outdev = outdev;
+  flow->proto  = proto;
+  flow->sport  = sport;
+  flow->dport  = dport;
+  flow->chain  = chain;
+  flow->valid  = true;
+}
+#endif /* CONFIG_NET_IPFILTER_FLOWCACHE > 0 */
+
 /****************************************************************************
  * Name: ipv4_filter_match / ipv6_filter_match
  *
@@ -213,11 +469,19 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv4_hdr_s *ipv4,
                              enum ipfilter_chain_e chain)
 {
+  FAR const struct ipfilter_index_s *index = &g_ipv4_index[chain];
   FAR const struct ipv4_filter_entry_s *filter;
-  FAR const sq_queue_t *queue = &g_ipv4_filters[chain];
-  FAR const sq_entry_t *entry;
+  FAR const struct ipfilter_entry_s *bucket = NULL;
+  FAR const struct ipfilter_entry_s *other;
+  FAR const struct ipfilter_entry_s *entry;
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+  FAR struct ipv4_filter_flow_s *flow = NULL;
+#endif
   FAR const void *l4hdr;
-  in_addr_t ipaddr;
+  in_addr_t srcipaddr;
+  in_addr_t destipaddr;
+  uint16_t sport = 0;
+  uint16_t dport = 0;
   bool matched;
 
   /* Handle unexpected status, return ACCEPT to indicate doing nothing. */
@@ -227,32 +491,59 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
       return IPFILTER_TARGET_ACCEPT;
     }
 
-  l4hdr = IPv4_L4HDR(ipv4);
+  l4hdr      = IPv4_L4HDR(ipv4);
+  srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
 
-  sq_for_every(queue, entry)
+  if (IPFILTER_HASPORTS(ipv4->proto))
     {
-      filter = (FAR struct ipv4_filter_entry_s *)entry;
+      /* Ports in TCP & UDP headers have same offset. */
+
+      FAR const struct udp_hdr_s *udp = l4hdr;
+
+      sport  = NTOHS(udp->srcport);
+      dport  = NTOHS(udp->destport);
+      bucket = index->bucket[ipfilter_hash(ipv4->proto, dport)];
+
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      /* Packets of an already accepted flow need no rule at all. */
+
+      flow = ipv4_filter_flow(srcipaddr, destipaddr, sport, dport);
+      if (ipfilter_flow_match(&flow->common, indev, outdev, ipv4->proto,
+                              sport, dport, chain) &&
+          net_ipv4addr_cmp(flow->sip, srcipaddr) &&
+          net_ipv4addr_cmp(flow->dip, destipaddr))
+        {
+          return IPFILTER_TARGET_ACCEPT;
+        }
+#endif
+    }
+
+  /* Visit only the rules that may match, in chain order. */
+
+  other = index->other;
+  while ((entry = ipfilter_index_next(&bucket, &other)) != NULL)
+    {
+      filter = (FAR const struct ipv4_filter_entry_s *)entry;
 
       /* Match device */
 
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
+      if (!ipfilter_match_device(entry, indev, outdev))
         {
           continue;
         }
 
       /* Match addresses */
 
-      ipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
-      matched = net_ipv4addr_maskcmp(filter->sip, ipaddr, filter->smsk)
-                ^ filter->common.inv_srcip;
+      matched = net_ipv4addr_maskcmp(filter->sip, srcipaddr, filter->smsk)
+                ^ entry->inv_srcip;
       if (!matched)
         {
           continue;
         }
 
-      ipaddr  = net_ip4addr_conv32(ipv4->destipaddr);
-      matched = net_ipv4addr_maskcmp(filter->dip, ipaddr, filter->dmsk)
-                ^ filter->common.inv_dstip;
+      matched = net_ipv4addr_maskcmp(filter->dip, destipaddr, filter->dmsk)
+                ^ entry->inv_dstip;
       if (!matched)
         {
           continue;
@@ -260,14 +551,24 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
 
       /* Match protocol */
 
-      if (!ipfilter_match_proto(&filter->common, l4hdr, ipv4->proto))
+      if (!ipfilter_match_proto(entry, l4hdr, ipv4->proto))
         {
           continue;
         }
 
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      if (flow != NULL && entry->target == IPFILTER_TARGET_ACCEPT)
+        {
+          ipfilter_flow_set(&flow->common, indev, outdev, ipv4->proto,
+                            sport, dport, chain);
+          net_ipv4addr_copy(flow->sip, srcipaddr);
+          net_ipv4addr_copy(flow->dip, destipaddr);
+        }
+#endif
+
       /* Return the target action if matched. */
 
-      return filter->common.target;
+      return entry->target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -283,10 +584,17 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv6_hdr_s *ipv6,
                              enum ipfilter_chain_e chain)
 {
+  FAR const struct ipfilter_index_s *index = &g_ipv6_index[chain];
   FAR const struct ipv6_filter_entry_s *filter;
-  FAR const sq_queue_t *queue = &g_ipv6_filters[chain];
-  FAR const sq_entry_t *entry;
+  FAR const struct ipfilter_entry_s *bucket = NULL;
+  FAR const struct ipfilter_entry_s *other;
+  FAR const struct ipfilter_entry_s *entry;
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+  FAR struct ipv6_filter_flow_s *flow = NULL;
+#endif
   FAR const void *l4hdr;
+  uint16_t sport = 0;
+  uint16_t dport = 0;
   uint8_t proto;
   bool matched;
 
@@ -299,13 +607,41 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 
   l4hdr = IPv6_L4HDR(ipv6, proto);
 
-  sq_for_every(queue, entry)
+  if (IPFILTER_HASPORTS(proto))
     {
-      filter = (FAR struct ipv6_filter_entry_s *)entry;
+      /* Ports in TCP & UDP headers have same offset. */
+
+      FAR const struct udp_hdr_s *udp = l4hdr;
+
+      sport  = NTOHS(udp->srcport);
+      dport  = NTOHS(udp->destport);
+      bucket = index->bucket[ipfilter_hash(proto, dport)];
+
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      /* Packets of an already accepted flow need no rule at all. */
+
+      flow = ipv6_filter_flow(ipv6->srcipaddr, ipv6->destipaddr,
+                              sport, dport);
+      if (ipfilter_flow_match(&flow->common, indev, outdev, proto,
+                              sport, dport, chain) &&
+          net_ipv6addr_cmp(flow->sip, ipv6->srcipaddr) &&
+          net_ipv6addr_cmp(flow->dip, ipv6->destipaddr))
+        {
+          return IPFILTER_TARGET_ACCEPT;
+        }
+#endif
+    }
+
+  /* Visit only the rules that may match, in chain order. */
+
+  other = index->other;
+  while ((entry = ipfilter_index_next(&bucket, &other)) != NULL)
+    {
+      filter = (FAR const struct ipv6_filter_entry_s *)entry;
 
       /* Match device */
 
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
+      if (!ipfilter_match_device(entry, indev, outdev))
         {
           continue;
         }
@@ -314,7 +650,7 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 
       matched = net_ipv6addr_maskcmp(filter->sip, ipv6->srcipaddr,
                                      filter->smsk)
-                ^ filter->common.inv_srcip;
+                ^ entry->inv_srcip;
       if (!matched)
         {
           continue;
@@ -322,7 +658,7 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 
       matched = net_ipv6addr_maskcmp(filter->dip, ipv6->destipaddr,
                                      filter->dmsk)
-                ^ filter->common.inv_dstip;
+                ^ entry->inv_dstip;
       if (!matched)
         {
           continue;
@@ -330,14 +666,24 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
 
       /* Match protocol */
 
-      if (!ipfilter_match_proto(&filter->common, l4hdr, proto))
+      if (!ipfilter_match_proto(entry, l4hdr, proto))
         {
           continue;
         }
 
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      if (flow != NULL && entry->target == IPFILTER_TARGET_ACCEPT)
+        {
+          ipfilter_flow_set(&flow->common, indev, outdev, proto,
+                            sport, dport, chain);
+          net_ipv6addr_copy(flow->sip, ipv6->srcipaddr);
+          net_ipv6addr_copy(flow->dip, ipv6->destipaddr);
+        }
+#endif
+
       /* Return the target action if matched. */
 
-      return filter->common.target;
+      return entry->target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -392,7 +738,7 @@ FAR struct ipfilter_entry_s *ipfilter_cfg_alloc(sa_family_t family)
  *
  * Description:
  *   Add a new filter configuration entry for the given address family to the
- *   end of specified chain.
+ *   end of specified chain, and compile it into the index of the chain.
  *
  * Input Parameters:
  *   entry  - The filter entry to add
@@ -411,6 +757,10 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
   if (family == PF_INET)
     {
       sq_addlast((FAR sq_entry_t *)entry, &g_ipv4_filters[chain]);
+      ipfilter_index_add(&g_ipv4_index[chain], entry);
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      memset(g_ipv4_flows, 0, sizeof(g_ipv4_flows));
+#endif
     }
 #endif
 
@@ -418,6 +768,10 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
   if (family == PF_INET6)
     {
       sq_addlast((FAR sq_entry_t *)entry, &g_ipv6_filters[chain]);
+      ipfilter_index_add(&g_ipv6_index[chain], entry);
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      memset(g_ipv6_flows, 0, sizeof(g_ipv6_flows));
+#endif
     }
 #endif
 }
@@ -448,6 +802,11 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
         {
           kmm_free(sq_remfirst(queue));
         }
+
+      memset(&g_ipv4_index[chain], 0, sizeof(g_ipv4_index[chain]));
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      memset(g_ipv4_flows, 0, sizeof(g_ipv4_flows));
+#endif
     }
 #endif
 
@@ -459,6 +818,11 @@ void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
         {
           kmm_free(sq_remfirst(queue));
         }
+
+      memset(&g_ipv6_index[chain], 0, sizeof(g_ipv6_index[chain]));
+#if CONFIG_NET_IPFILTER_FLOWCACHE > 0
+      memset(g_ipv6_flows, 0, sizeof(g_ipv6_flows));
+#endif
     }
 #endif
 }
@@ -61,6 +61,8 @@ enum ipfilter_chain_e
 struct ipfilter_entry_s
 {
   FAR struct ipfilter_entry_s *flink;
+  FAR struct ipfilter_entry_s *inext; /* Next candidate in compiled index */
+  uint16_t seq;                       /* Position of the rule in chain */
 
   FAR struct net_driver_s *indev;
   FAR struct net_driver_s *outdev;
@@ -149,7 +151,7 @@ FAR struct ipfilter_entry_s *ipfilter_cfg_alloc(sa_family_t family);
  *
  * Description:
  *   Add a new filter configuration entry for the given address family to the
- *   end of specified chain.
+ *   end of specified chain, and compile it into the index of the chain.
  *
  * Input Parameters:
  *   entry  - The filter entry to add
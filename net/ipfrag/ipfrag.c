@@ -1251,6 +1251,15 @@ int32_t ip_fragout(FAR struct net_driver_s *dev)
       return OK;
     }
 
+#ifdef CONFIG_NETDEV_GSO
+  /* TCP super-segments are split by the driver, never fragmented */
+
+  if (dev->d_gso_size > 0)
+    {
+      return OK;
+    }
+#endif
+
 #ifdef CONFIG_NET_6LOWPAN
   if (dev->d_lltype == NET_LL_IEEE802154 ||
       dev->d_lltype == NET_LL_PKTRADIO)
@@ -51,6 +51,14 @@
 #define LOCAL_NPOLLWAITERS 2
 #define LOCAL_NCONTROLFDS  4
 
+/* Whether a connection talks to its peer through local_ring_s */
+
+#ifdef CONFIG_NET_LOCAL_RING
+#  define LOCAL_ISRING(conn) ((conn)->lc_rxring != NULL)
+#else
+#  define LOCAL_ISRING(conn) false
+#endif
+
 #if CONFIG_DEV_PIPE_MAXSIZE > 65535
 typedef uint32_t lc_size_t;  /* 32-bit index */
 #elif CONFIG_DEV_PIPE_MAXSIZE > 255
@@ -110,6 +118,7 @@ enum local_state_s
  */
 
 struct devif_callback_s;       /* Forward reference */
+struct local_ring_s;           /* Forward reference */
 
 struct local_conn_s
 {
@@ -134,6 +143,12 @@ struct local_conn_s
 
   FAR struct local_conn_s *
                         lc_peer; /* Peer connection instance */
+#ifdef CONFIG_NET_LOCAL_RING
+  FAR struct local_ring_s *
+                      lc_rxring; /* Ring carrying data from the peer */
+  FAR struct local_ring_s *
+                      lc_txring; /* Ring carrying data to the peer */
+#endif
 #ifdef CONFIG_NET_LOCAL_SCM
   uint16_t lc_cfpcount;          /* Control file pointer counter */
   FAR struct file *
@@ -144,16 +159,19 @@ struct local_conn_s
   mutex_t lc_sendlock;           /* Make sending multi-thread safe */
   mutex_t lc_polllock;           /* Lock for net poll */
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-  /* SOCK_STREAM fields common to both client and server */
-
-  sem_t lc_waitsem;            /* Use to wait for a connection to be accepted */
-
+#if defined(CONFIG_NET_LOCAL_STREAM) || defined(CONFIG_NET_LOCAL_RING)
   /* The following is a list if poll structures of threads waiting for
    * socket events.
    */
 
   FAR struct pollfd *lc_event_fds[LOCAL_NPOLLWAITERS];
+#endif
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+  /* SOCK_STREAM fields common to both client and server */
+
+  sem_t lc_waitsem;            /* Use to wait for a connection to be accepted */
+
   struct pollfd lc_inout_fds[2*LOCAL_NPOLLWAITERS];
 
   /* Union of fields unique to SOCK_STREAM client, server, and connected
@@ -672,6 +690,141 @@ int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
                       bool nonblock);
 #endif
 
+/****************************************************************************
+ * Name: local_ring_alloc
+ *
+ * Description:
+ *   Connect two local connections through a pair of rings, one for each
+ *   direction.  Each ring is sized by the receive buffer size of the
+ *   connection reading from it.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_alloc(FAR struct local_conn_s *conn,
+                     FAR struct local_conn_s *peer);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Detach a connection from both of its rings, shutting them down.  A
+ *   ring is freed when it has been released by both of its ends.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_release(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Disable further receive (SHUT_RD) and/or send (SHUT_WR) operations on
+ *   a ring connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+void local_ring_shutdown(FAR struct local_conn_s *conn, int how);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send data to the peer of a ring connection.  A datagram is either
+ *   queued as a whole or not at all; a stream may be sent partially if the
+ *   socket does not block.
+ *
+ * Input Parameters:
+ *   conn     The sending connection
+ *   buf      Data to send
+ *   len      Number of entries in buf
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   The number of bytes sent on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *buf, size_t len, int flags);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Receive data from the peer of a ring connection.  A datagram larger
+ *   than the buffer is truncated.
+ *
+ * Input Parameters:
+ *   conn     The receiving connection
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of bytes received on success, zero if the peer has shut
+ *   down its sending side; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, int flags);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_pollevents
+ *
+ * Description:
+ *   Return the poll events currently pending on a ring connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+pollevent_t local_ring_pollevents(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_ioctl
+ *
+ * Description:
+ *   Handle the ioctl commands that depend on the transport of a ring
+ *   connection.  Returns -ENOTTY for all other commands.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_ioctl(FAR struct local_conn_s *conn, int cmd,
+                     unsigned long arg);
+#endif
+
+/****************************************************************************
+ * Name: local_ring_resize
+ *
+ * Description:
+ *   Change the size of the receiving (rx true) or sending ring of a ring
+ *   connection.  The data already queued is kept, so the new size must be
+ *   large enough to hold it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+int local_ring_resize(FAR struct local_conn_s *conn, bool rx, size_t size);
+#endif
+
 /****************************************************************************
  * Name: local_event_pollnotify
  ****************************************************************************/
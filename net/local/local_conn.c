@@ -222,6 +222,21 @@ int local_alloc_accept(FAR struct local_conn_s *server,
   strlcpy(conn->lc_path, server->lc_path, sizeof(conn->lc_path));
   conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connect the peers directly through rings instead of FIFOs */
+
+  conn->lc_rcvsize = server->lc_rcvsize;
+  ret = local_ring_alloc(conn, client);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to create rings for %s: %d\n",
+           client->lc_path, ret);
+      goto err;
+    }
+
+  *accept = conn;
+  return OK;
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conn, server->lc_rcvsize, client->lc_rcvsize);
@@ -269,6 +284,7 @@ int local_alloc_accept(FAR struct local_conn_s *server,
 
 errout_with_fifos:
   local_release_fifos(conn);
+#endif /* CONFIG_NET_LOCAL_RING */
 
 err:
   local_free(conn);
@@ -305,6 +321,12 @@ void local_free(FAR struct local_conn_s *conn)
       conn->lc_peer = NULL;
     }
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Shut down and release the rings shared with the peer */
+
+  local_ring_release(conn);
+#endif
+
   /* Make sure that the read-only FIFO is closed */
 
   if (conn->lc_infile.f_inode != NULL)
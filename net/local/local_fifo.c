@@ -771,6 +771,13 @@ int local_set_nonblocking(FAR struct local_conn_s *conn)
   int nonblock = 1;
   int ret;
 
+  /* A ring connection follows the non-blocking flag of its socket */
+
+  if (LOCAL_ISRING(conn))
+    {
+      return OK;
+    }
+
   /* Set the conn to nonblocking mode */
 
   ret  = file_ioctl(&conn->lc_infile, FIONBIO, &nonblock);
@@ -43,7 +43,7 @@
  * Name: local_event_pollsetup
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_STREAM
+#if defined(CONFIG_NET_LOCAL_STREAM) || defined(CONFIG_NET_LOCAL_RING)
 static int local_event_pollsetup(FAR struct local_conn_s *conn,
                                  FAR struct pollfd *fds,
                                  bool setup)
@@ -80,11 +80,20 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
           return -EBUSY;
         }
 
+#ifdef CONFIG_NET_LOCAL_RING
+      if (LOCAL_ISRING(conn))
+        {
+          poll_notify(&fds, 1, local_ring_pollevents(conn));
+        }
+#endif
+
+#ifdef CONFIG_NET_LOCAL_STREAM
       if (conn->lc_state == LOCAL_STATE_LISTENING &&
           dq_peek(&conn->u.server.lc_waiters) != NULL)
         {
           poll_notify(&fds, 1, POLLIN);
         }
+#endif
     }
   else
     {
@@ -107,11 +116,13 @@ static int local_event_pollsetup(FAR struct local_conn_s *conn,
 
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: local_inout_poll_cb
  ****************************************************************************/
 
+#ifdef CONFIG_NET_LOCAL_STREAM
 static void local_inout_poll_cb(FAR struct pollfd *fds)
 {
   FAR struct pollfd *originfds = fds->arg;
@@ -131,7 +142,7 @@ static void local_inout_poll_cb(FAR struct pollfd *fds)
 void local_event_pollnotify(FAR struct local_conn_s *conn,
                             pollevent_t eventset)
 {
-#ifdef CONFIG_NET_LOCAL_STREAM
+#if defined(CONFIG_NET_LOCAL_STREAM) || defined(CONFIG_NET_LOCAL_RING)
   nxmutex_lock(&conn->lc_polllock);
   poll_notify(conn->lc_event_fds, LOCAL_NPOLLWAITERS, eventset);
   nxmutex_unlock(&conn->lc_polllock);
@@ -159,6 +170,15 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Both directions of a ring connection report to the same waiters */
+
+  if (LOCAL_ISRING(conn))
+    {
+      return local_event_pollsetup(conn, fds, true);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return -ENOSYS;
@@ -308,6 +328,13 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (LOCAL_ISRING(conn))
+    {
+      return local_event_pollsetup(conn, fds, false);
+    }
+#endif
+
   if (conn->lc_proto == SOCK_DGRAM)
     {
       return -ENOSYS;
@@ -291,6 +291,64 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 }
 #endif /* CONFIG_NET_LOCAL_STREAM */
 
+/****************************************************************************
+ * Name: psock_ring_recvfrom
+ *
+ * Description:
+ *   psock_ring_recvfrom() receives messages from a local socket connected
+ *   through a ring, whether stream or datagram.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly shutdown,
+ *   zero is returned.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_RING
+static inline ssize_t
+psock_ring_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
+                    int flags, FAR struct sockaddr *from,
+                    FAR socklen_t *fromlen)
+{
+  FAR struct local_conn_s *conn = psock->s_conn;
+  ssize_t readlen;
+  int ret;
+
+  readlen = local_ring_recv(conn, buf, len, flags);
+  if (readlen < 0)
+    {
+      if (readlen != -EAGAIN)
+        {
+          nerr("ERROR: Failed to read packet: %zd\n", readlen);
+        }
+
+      return readlen;
+    }
+
+  /* Return the address family */
+
+  if (from)
+    {
+      ret = local_getaddr(conn, from, fromlen);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return readlen;
+}
+#endif /* CONFIG_NET_LOCAL_RING */
+
 /****************************************************************************
  * Name: psock_fifo_discard
  *
@@ -547,13 +605,23 @@ ssize_t local_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Check shutdown state */
 
-  if (conn->lc_infile.f_inode == NULL)
+  if (conn->lc_infile.f_inode == NULL && !LOCAL_ISRING(conn))
     {
       return 0;
     }
 
   DEBUGASSERT(buf);
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Check for a socket connected through a ring */
+
+  if (LOCAL_ISRING(conn))
+    {
+      len = psock_ring_recvfrom(psock, buf, len, flags, from, fromlen);
+    }
+  else
+#endif
+
   /* Check for a stream socket */
 
 #ifdef CONFIG_NET_LOCAL_STREAM
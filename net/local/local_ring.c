@@ -0,0 +1,845 @@
+/****************************************************************************
+ * net/local/local_ring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_RING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A writer may copy straight into the buffer of a blocked reader only if
+ * that buffer is addressable from the writer's context.
+ */
+
+#ifndef CONFIG_ARCH_ADDRENV
+#  define LOCAL_RING_HANDOFF 1
+#endif
+
+/* Each datagram is stored in the ring behind its length */
+
+#define LOCAL_RING_HDRLEN sizeof(lc_size_t)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A blocked reader offering its own buffer to the next writer */
+
+#ifdef LOCAL_RING_HANDOFF
+struct local_ring_waiter_s
+{
+  FAR uint8_t *lw_buf;       /* Receive buffer of the reader */
+  size_t lw_len;             /* Size of the receive buffer */
+  size_t lw_copied;          /* Number of bytes copied by the writer */
+  bool lw_done;              /* Set by the writer once the copy is done */
+};
+#endif
+
+/* One direction of a connection.  The ring is shared by the two peers:
+ * the sender copies into it and the receiver copies out of it, with no
+ * inode or pipe driver in between.
+ */
+
+struct local_ring_s
+{
+  mutex_t lr_lock;                    /* Protects all fields below */
+  sem_t lr_rdsem;                     /* Readers wait here for data */
+  sem_t lr_wrsem;                     /* Writers wait here for space */
+  FAR struct local_conn_s *lr_reader; /* Receiving end, NULL if released */
+  FAR struct local_conn_s *lr_writer; /* Sending end, NULL if released */
+#ifdef LOCAL_RING_HANDOFF
+  FAR struct local_ring_waiter_s *lr_waiter; /* Reader waiting for data */
+#endif
+  FAR uint8_t *lr_buffer;             /* Ring storage */
+  size_t lr_size;                     /* Size of the ring storage */
+  size_t lr_tail;                     /* Offset of the oldest byte */
+  size_t lr_used;                     /* Number of bytes in the ring */
+  bool lr_dgram;                      /* Preserve message boundaries */
+  bool lr_rdshut;                     /* Receiving end was shut down */
+  bool lr_wrshut;                     /* Sending end was shut down */
+};
+
+/* Cursor over the I/O vector of a send */
+
+struct local_iter_s
+{
+  FAR const struct iovec *li_iov;
+  FAR const struct iovec *li_end;
+  size_t li_off;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_wakeup
+ ****************************************************************************/
+
+static void local_ring_wakeup(FAR sem_t *sem)
+{
+  int sval;
+
+  while (nxsem_get_value(sem, &sval) == OK && sval <= 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_iter_copy
+ *
+ * Description:
+ *   Copy up to len bytes from the I/O vector into a flat buffer.  Returns
+ *   the number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t local_iter_copy(FAR struct local_iter_s *iter,
+                              FAR uint8_t *dest, size_t len)
+{
+  size_t total = 0;
+  size_t ncopy;
+
+  while (len > 0 && iter->li_iov != iter->li_end)
+    {
+      ncopy = MIN(len, iter->li_iov->iov_len - iter->li_off);
+      memcpy(dest + total,
+             (FAR const uint8_t *)iter->li_iov->iov_base + iter->li_off,
+             ncopy);
+
+      total        += ncopy;
+      len          -= ncopy;
+      iter->li_off += ncopy;
+
+      if (iter->li_off == iter->li_iov->iov_len)
+        {
+          iter->li_iov++;
+          iter->li_off = 0;
+        }
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: local_ring_put
+ *
+ * Description:
+ *   Append len bytes from the I/O vector (or from src if iter is NULL) to
+ *   the ring.  The caller has checked that they fit.
+ *
+ ****************************************************************************/
+
+static void local_ring_put(FAR struct local_ring_s *ring,
+                           FAR struct local_iter_s *iter,
+                           FAR const void *src, size_t len)
+{
+  size_t off = (ring->lr_tail + ring->lr_used) % ring->lr_size;
+  size_t ncopy = MIN(len, ring->lr_size - off);
+
+  if (iter != NULL)
+    {
+      local_iter_copy(iter, ring->lr_buffer + off, ncopy);
+      local_iter_copy(iter, ring->lr_buffer, len - ncopy);
+    }
+  else
+    {
+      memcpy(ring->lr_buffer + off, src, ncopy);
+      memcpy(ring->lr_buffer, (FAR const uint8_t *)src + ncopy,
+             len - ncopy);
+    }
+
+  ring->lr_used += len;
+}
+
+/****************************************************************************
+ * Name: local_ring_get
+ *
+ * Description:
+ *   Copy len bytes starting offset bytes past the oldest byte of the ring.
+ *   Nothing is removed from the ring.
+ *
+ ****************************************************************************/
+
+static void local_ring_get(FAR struct local_ring_s *ring, FAR void *dest,
+                           size_t offset, size_t len)
+{
+  size_t off = (ring->lr_tail + offset) % ring->lr_size;
+  size_t ncopy = MIN(len, ring->lr_size - off);
+
+  memcpy(dest, ring->lr_buffer + off, ncopy);
+  memcpy((FAR uint8_t *)dest + ncopy, ring->lr_buffer, len - ncopy);
+}
+
+/****************************************************************************
+ * Name: local_ring_consume
+ *
+ * Description:
+ *   Remove len bytes from the ring and let the writers know.
+ *
+ ****************************************************************************/
+
+static void local_ring_consume(FAR struct local_ring_s *ring, size_t len)
+{
+  ring->lr_tail  = (ring->lr_tail + len) % ring->lr_size;
+  ring->lr_used -= len;
+  if (ring->lr_used == 0)
+    {
+      ring->lr_tail = 0;
+    }
+
+  local_ring_wakeup(&ring->lr_wrsem);
+  if (ring->lr_writer != NULL)
+    {
+      local_event_pollnotify(ring->lr_writer, POLLOUT);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_create
+ ****************************************************************************/
+
+static FAR struct local_ring_s *local_ring_create(size_t size, bool dgram)
+{
+  FAR struct local_ring_s *ring;
+
+  ring = kmm_zalloc(sizeof(struct local_ring_s));
+  if (ring == NULL)
+    {
+      return NULL;
+    }
+
+  ring->lr_buffer = kmm_malloc(size);
+  if (ring->lr_buffer == NULL)
+    {
+      kmm_free(ring);
+      return NULL;
+    }
+
+  nxmutex_init(&ring->lr_lock);
+  nxsem_init(&ring->lr_rdsem, 0, 0);
+  nxsem_init(&ring->lr_wrsem, 0, 0);
+
+  ring->lr_size  = size;
+  ring->lr_dgram = dgram;
+  return ring;
+}
+
+/****************************************************************************
+ * Name: local_ring_destroy
+ ****************************************************************************/
+
+static void local_ring_destroy(FAR struct local_ring_s *ring)
+{
+  nxsem_destroy(&ring->lr_wrsem);
+  nxsem_destroy(&ring->lr_rdsem);
+  nxmutex_destroy(&ring->lr_lock);
+  kmm_free(ring->lr_buffer);
+  kmm_free(ring);
+}
+
+/****************************************************************************
+ * Name: local_ring_shutrd / local_ring_shutwr
+ *
+ * Description:
+ *   Mark one end of a ring as shut down and wake everybody waiting on it.
+ *   Called with the ring locked.
+ *
+ ****************************************************************************/
+
+static void local_ring_shutrd(FAR struct local_ring_s *ring)
+{
+  ring->lr_rdshut = true;
+  local_ring_wakeup(&ring->lr_rdsem);
+  local_ring_wakeup(&ring->lr_wrsem);
+
+  if (ring->lr_writer != NULL)
+    {
+      local_event_pollnotify(ring->lr_writer, POLLERR);
+    }
+}
+
+static void local_ring_shutwr(FAR struct local_ring_s *ring)
+{
+  ring->lr_wrshut = true;
+  local_ring_wakeup(&ring->lr_rdsem);
+  local_ring_wakeup(&ring->lr_wrsem);
+
+  if (ring->lr_reader != NULL)
+    {
+      local_event_pollnotify(ring->lr_reader, POLLIN | POLLHUP);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_alloc
+ *
+ * Description:
+ *   Connect two local connections through a pair of rings, one for each
+ *   direction.  Each ring is sized by the receive buffer size of the
+ *   connection reading from it.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+int local_ring_alloc(FAR struct local_conn_s *conn,
+                     FAR struct local_conn_s *peer)
+{
+  bool dgram = conn->lc_proto == SOCK_DGRAM;
+  FAR struct local_ring_s *rx;
+  FAR struct local_ring_s *tx;
+
+  rx = local_ring_create(conn->lc_rcvsize, dgram);
+  if (rx == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  tx = local_ring_create(peer->lc_rcvsize, dgram);
+  if (tx == NULL)
+    {
+      local_ring_destroy(rx);
+      return -ENOMEM;
+    }
+
+  rx->lr_reader = conn;
+  rx->lr_writer = peer;
+  tx->lr_reader = peer;
+  tx->lr_writer = conn;
+
+  conn->lc_rxring = rx;
+  conn->lc_txring = tx;
+  peer->lc_rxring = tx;
+  peer->lc_txring = rx;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_ring_release
+ *
+ * Description:
+ *   Detach a connection from both of its rings, shutting them down.  A
+ *   ring is freed when it has been released by both of its ends.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void local_ring_release(FAR struct local_conn_s *conn)
+{
+  FAR struct local_ring_s *rx = conn->lc_rxring;
+  FAR struct local_ring_s *tx = conn->lc_txring;
+  bool freeing;
+
+  if (rx != NULL)
+    {
+      nxmutex_lock(&rx->lr_lock);
+      local_ring_shutrd(rx);
+      rx->lr_reader = NULL;
+      freeing = rx->lr_writer == NULL;
+      nxmutex_unlock(&rx->lr_lock);
+
+      if (freeing)
+        {
+          local_ring_destroy(rx);
+        }
+    }
+
+  if (tx != NULL)
+    {
+      nxmutex_lock(&tx->lr_lock);
+      local_ring_shutwr(tx);
+      tx->lr_writer = NULL;
+      freeing = tx->lr_reader == NULL;
+      nxmutex_unlock(&tx->lr_lock);
+
+      if (freeing)
+        {
+          local_ring_destroy(tx);
+        }
+    }
+
+  conn->lc_rxring = NULL;
+  conn->lc_txring = NULL;
+}
+
+/****************************************************************************
+ * Name: local_ring_shutdown
+ *
+ * Description:
+ *   Disable further receive (SHUT_RD) and/or send (SHUT_WR) operations on
+ *   a ring connection.
+ *
+ ****************************************************************************/
+
+void local_ring_shutdown(FAR struct local_conn_s *conn, int how)
+{
+  if (how & SHUT_RD)
+    {
+      nxmutex_lock(&conn->lc_rxring->lr_lock);
+      local_ring_shutrd(conn->lc_rxring);
+      nxmutex_unlock(&conn->lc_rxring->lr_lock);
+    }
+
+  if (how & SHUT_WR)
+    {
+      nxmutex_lock(&conn->lc_txring->lr_lock);
+      local_ring_shutwr(conn->lc_txring);
+      nxmutex_unlock(&conn->lc_txring->lr_lock);
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_send
+ *
+ * Description:
+ *   Send data to the peer of a ring connection.  A datagram is either
+ *   queued as a whole or not at all; a stream may be sent partially if the
+ *   socket does not block.
+ *
+ * Input Parameters:
+ *   conn     The sending connection
+ *   buf      Data to send
+ *   len      Number of entries in buf
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   The number of bytes sent on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_send(FAR struct local_conn_s *conn,
+                        FAR const struct iovec *buf, size_t len, int flags)
+{
+  FAR struct local_ring_s *ring = conn->lc_txring;
+  bool nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+                  (flags & MSG_DONTWAIT) != 0;
+  FAR const struct iovec *end = buf + len;
+  FAR const struct iovec *iov;
+  struct local_iter_s iter;
+  size_t remain = 0;
+  size_t sent = 0;
+  size_t space;
+  size_t ncopy;
+  ssize_t ret = OK;
+  lc_size_t pktlen;
+
+  for (iov = buf; iov != end; iov++)
+    {
+      remain += iov->iov_len;
+    }
+
+  iter.li_iov = buf;
+  iter.li_end = end;
+  iter.li_off = 0;
+
+  pktlen = remain;
+  if (ring->lr_dgram ? pktlen != remain : remain == 0)
+    {
+      return ring->lr_dgram ? -EMSGSIZE : 0;
+    }
+
+  nxmutex_lock(&ring->lr_lock);
+
+  for (; ; )
+    {
+      if (ring->lr_rdshut || ring->lr_wrshut)
+        {
+          ret = -EPIPE;
+          break;
+        }
+
+      if (ring->lr_dgram && remain + LOCAL_RING_HDRLEN > ring->lr_size)
+        {
+          ret = -EMSGSIZE;
+          break;
+        }
+
+#ifdef LOCAL_RING_HANDOFF
+      /* Copy straight into the buffer of a reader blocked on the empty
+       * ring, sparing the second copy through the ring.
+       */
+
+      if (ring->lr_waiter != NULL)
+        {
+          FAR struct local_ring_waiter_s *waiter = ring->lr_waiter;
+
+          DEBUGASSERT(ring->lr_used == 0);
+
+          ncopy = local_iter_copy(&iter, waiter->lw_buf,
+                                  MIN(remain, waiter->lw_len));
+          waiter->lw_copied = ncopy;
+          waiter->lw_done   = true;
+          ring->lr_waiter   = NULL;
+          local_ring_wakeup(&ring->lr_rdsem);
+
+          /* The rest of a datagram that did not fit is discarded. */
+
+          ncopy   = ring->lr_dgram ? remain : ncopy;
+          sent   += ncopy;
+          remain -= ncopy;
+          if (remain == 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+#endif
+
+      space = ring->lr_size - ring->lr_used;
+      if (ring->lr_dgram ? space >= remain + LOCAL_RING_HDRLEN : space > 0)
+        {
+          if (ring->lr_dgram)
+            {
+              local_ring_put(ring, NULL, &pktlen, LOCAL_RING_HDRLEN);
+            }
+
+          ncopy = MIN(space, remain);
+          local_ring_put(ring, &iter, NULL, ncopy);
+          sent   += ncopy;
+          remain -= ncopy;
+
+          local_ring_wakeup(&ring->lr_rdsem);
+          if (ring->lr_reader != NULL)
+            {
+              local_event_pollnotify(ring->lr_reader, POLLIN);
+            }
+
+          if (remain == 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      /* Not enough space.  Return what was sent so far, or wait. */
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      nxmutex_unlock(&ring->lr_lock);
+      ret = nxsem_wait(&ring->lr_wrsem);
+      nxmutex_lock(&ring->lr_lock);
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+  return sent > 0 ? sent : ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_recv
+ *
+ * Description:
+ *   Receive data from the peer of a ring connection.  A datagram larger
+ *   than the buffer is truncated.
+ *
+ * Input Parameters:
+ *   conn     The receiving connection
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   The number of bytes received on success, zero if the peer has shut
+ *   down its sending side; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_ring_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                        size_t len, int flags)
+{
+  FAR struct local_ring_s *ring = conn->lc_rxring;
+  bool nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+                  (flags & MSG_DONTWAIT) != 0;
+#ifdef LOCAL_RING_HANDOFF
+  struct local_ring_waiter_s waiter;
+#endif
+  lc_size_t pktlen;
+  size_t offset = 0;
+  ssize_t ret = OK;
+
+  nxmutex_lock(&ring->lr_lock);
+
+  while (ring->lr_used == 0)
+    {
+      /* Report end of file once the peer stops sending */
+
+      if (ring->lr_rdshut || ring->lr_wrshut)
+        {
+          goto out;
+        }
+
+      if (nonblock)
+        {
+          ret = -EAGAIN;
+          goto out;
+        }
+
+#ifdef LOCAL_RING_HANDOFF
+      /* Offer the buffer to the next writer, unless only peeking */
+
+      waiter.lw_done = false;
+      if ((flags & MSG_PEEK) == 0 && len > 0 && ring->lr_waiter == NULL)
+        {
+          waiter.lw_buf    = buf;
+          waiter.lw_len    = len;
+          waiter.lw_copied = 0;
+          ring->lr_waiter  = &waiter;
+        }
+#endif
+
+      nxmutex_unlock(&ring->lr_lock);
+      ret = nxsem_wait(&ring->lr_rdsem);
+      nxmutex_lock(&ring->lr_lock);
+
+#ifdef LOCAL_RING_HANDOFF
+      if (waiter.lw_done)
+        {
+          ret = waiter.lw_copied;
+          goto out;
+        }
+
+      if (ring->lr_waiter == &waiter)
+        {
+          ring->lr_waiter = NULL;
+        }
+#endif
+
+      if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  if (ring->lr_dgram)
+    {
+      local_ring_get(ring, &pktlen, 0, LOCAL_RING_HDRLEN);
+      offset = LOCAL_RING_HDRLEN;
+    }
+  else
+    {
+      pktlen = ring->lr_used;
+    }
+
+  ret = MIN(len, pktlen);
+  local_ring_get(ring, buf, offset, ret);
+
+  if ((flags & MSG_PEEK) == 0)
+    {
+      local_ring_consume(ring, ring->lr_dgram ? offset + pktlen : ret);
+    }
+
+out:
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_ring_pollevents
+ *
+ * Description:
+ *   Return the poll events currently pending on a ring connection.
+ *
+ ****************************************************************************/
+
+pollevent_t local_ring_pollevents(FAR struct local_conn_s *conn)
+{
+  FAR struct local_ring_s *ring;
+  pollevent_t eventset = 0;
+
+  ring = conn->lc_rxring;
+  nxmutex_lock(&ring->lr_lock);
+  if (ring->lr_used > 0 || ring->lr_rdshut)
+    {
+      eventset |= POLLIN;
+    }
+
+  if (ring->lr_wrshut)
+    {
+      eventset |= POLLIN | POLLHUP;
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+
+  ring = conn->lc_txring;
+  nxmutex_lock(&ring->lr_lock);
+  if (ring->lr_rdshut)
+    {
+      eventset |= POLLERR;
+    }
+  else if (ring->lr_wrshut ||
+           ring->lr_size - ring->lr_used >
+           (ring->lr_dgram ? LOCAL_RING_HDRLEN : 0))
+    {
+      eventset |= POLLOUT;
+    }
+
+  nxmutex_unlock(&ring->lr_lock);
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: local_ring_ioctl
+ *
+ * Description:
+ *   Handle the ioctl commands that depend on the transport of a ring
+ *   connection.  Returns -ENOTTY for all other commands.
+ *
+ ****************************************************************************/
+
+int local_ring_ioctl(FAR struct local_conn_s *conn, int cmd,
+                     unsigned long arg)
+{
+  FAR int *value = (FAR int *)(uintptr_t)arg;
+  FAR struct local_ring_s *ring;
+  lc_size_t pktlen;
+
+  switch (cmd)
+    {
+      case FIONBIO:
+
+        /* The ring honours the non-blocking flag of the socket itself */
+
+        return OK;
+
+      case FIONREAD:
+        ring = conn->lc_rxring;
+        nxmutex_lock(&ring->lr_lock);
+        if (ring->lr_dgram && ring->lr_used > 0)
+          {
+            local_ring_get(ring, &pktlen, 0, LOCAL_RING_HDRLEN);
+            *value = pktlen;
+          }
+        else
+          {
+            *value = ring->lr_used;
+          }
+
+        nxmutex_unlock(&ring->lr_lock);
+        return OK;
+
+      case FIONWRITE:
+      case FIONSPACE:
+        ring = conn->lc_txring;
+        nxmutex_lock(&ring->lr_lock);
+        *value = cmd == FIONWRITE ? ring->lr_used :
+                 ring->lr_size - ring->lr_used;
+        nxmutex_unlock(&ring->lr_lock);
+        return OK;
+
+      case PIPEIOC_POLLINTHRD:
+      case PIPEIOC_POLLOUTTHRD:
+        return -EOPNOTSUPP;
+
+      default:
+        return -ENOTTY;
+    }
+}
+
+/****************************************************************************
+ * Name: local_ring_resize
+ *
+ * Description:
+ *   Change the size of the receiving (rx true) or sending ring of a ring
+ *   connection.  The data already queued is kept, so the new size must be
+ *   large enough to hold it.
+ *
+ ****************************************************************************/
+
+int local_ring_resize(FAR struct local_conn_s *conn, bool rx, size_t size)
+{
+  FAR struct local_ring_s *ring = rx ? conn->lc_rxring : conn->lc_txring;
+  FAR uint8_t *buffer;
+  int ret = OK;
+
+  if (size == 0)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&ring->lr_lock);
+
+  if (size < ring->lr_used)
+    {
+      ret = -EBUSY;
+      goto out;
+    }
+
+  buffer = kmm_malloc(size);
+  if (buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto out;
+    }
+
+  local_ring_get(ring, buffer, 0, ring->lr_used);
+  kmm_free(ring->lr_buffer);
+
+  ring->lr_buffer = buffer;
+  ring->lr_size   = size;
+  ring->lr_tail   = 0;
+  local_ring_wakeup(&ring->lr_wrsem);
+
+out:
+  nxmutex_unlock(&ring->lr_lock);
+  return ret;
+}
+
+#endif /* CONFIG_NET_LOCAL_RING */
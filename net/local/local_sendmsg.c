@@ -199,7 +199,7 @@ static ssize_t local_send(FAR struct socket *psock,
 
           /* Check shutdown state */
 
-          if (conn->lc_outfile.f_inode == NULL)
+          if (conn->lc_outfile.f_inode == NULL && !LOCAL_ISRING(conn))
             {
               return -EPIPE;
             }
@@ -214,7 +214,17 @@ static ssize_t local_send(FAR struct socket *psock,
               return ret;
             }
 
-          ret = local_send_packet(&conn->lc_outfile, buf, len);
+#ifdef CONFIG_NET_LOCAL_RING
+          if (LOCAL_ISRING(conn))
+            {
+              ret = local_ring_send(conn, buf, len, flags);
+            }
+          else
+#endif
+            {
+              ret = local_send_packet(&conn->lc_outfile, buf, len);
+            }
+
           nxmutex_unlock(&conn->lc_sendlock);
         }
         break;
@@ -439,7 +449,7 @@ ssize_t local_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Check shutdown state */
 
-  if (conn->lc_outfile.f_inode == NULL)
+  if (conn->lc_outfile.f_inode == NULL && !LOCAL_ISRING(conn))
     {
       return -EPIPE;
     }
@@ -669,6 +669,20 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
 
               net_lock();
 
+#ifdef CONFIG_NET_LOCAL_RING
+              if (LOCAL_ISRING(conn))
+                {
+                  rcvsize = MIN(*(FAR const int *)value,
+                                CONFIG_DEV_PIPE_MAXSIZE);
+                  ret = local_ring_resize(conn, false, rcvsize);
+                  if (ret == OK && conn->lc_peer)
+                    {
+                      conn->lc_peer->lc_rcvsize = rcvsize;
+                    }
+                }
+              else
+#endif
+
               /* Only SOCK_STREAM sockets need set the send buffer size */
 
               if (conn->lc_peer)
@@ -719,6 +733,13 @@ static int local_setsockopt(FAR struct socket *psock, int level, int option,
 #endif
 
               rcvsize = MIN(rcvsize, CONFIG_DEV_PIPE_MAXSIZE);
+#ifdef CONFIG_NET_LOCAL_RING
+              if (LOCAL_ISRING(conn))
+                {
+                  ret = local_ring_resize(conn, true, rcvsize);
+                }
+              else
+#endif
               if (conn->lc_infile.f_inode != NULL)
                 {
                   ret = file_ioctl(&conn->lc_infile, PIPEIOC_SETSIZE,
@@ -948,6 +969,19 @@ static int local_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
   FAR struct local_conn_s *conn = psock->s_conn;
   int ret = OK;
 
+#ifdef CONFIG_NET_LOCAL_RING
+  if (LOCAL_ISRING(conn))
+    {
+      ret = local_ring_ioctl(conn, cmd, arg);
+      if (ret != -ENOTTY)
+        {
+          return ret;
+        }
+
+      ret = OK;
+    }
+#endif
+
   switch (cmd)
     {
       case FIONBIO:
@@ -1031,7 +1065,9 @@ static int local_ioctl(FAR struct socket *psock, int cmd, unsigned long arg)
 static int local_socketpair(FAR struct socket *psocks[2])
 {
   FAR struct local_conn_s *conns[2];
+#ifndef CONFIG_NET_LOCAL_RING
   bool nonblock;
+#endif
   int ret;
   int i;
 
@@ -1053,6 +1089,21 @@ static int local_socketpair(FAR struct socket *psocks[2])
                            = -1;
 #endif
 
+#ifdef CONFIG_NET_LOCAL_RING
+  /* Connect the pair directly through rings instead of FIFOs */
+
+  net_lock();
+  ret = local_ring_alloc(conns[0], conns[1]);
+  net_unlock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  conns[0]->lc_state = conns[1]->lc_state
+                     = LOCAL_STATE_CONNECTED;
+  return OK;
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conns[0], conns[0]->lc_rcvsize,
@@ -1118,6 +1169,7 @@ static int local_socketpair(FAR struct socket *psocks[2])
 errout:
   local_release_fifos(conns[0]);
   return ret;
+#endif /* CONFIG_NET_LOCAL_RING */
 }
 
 /****************************************************************************
@@ -1151,6 +1203,15 @@ static int local_shutdown(FAR struct socket *psock, int how)
       case SOCK_STREAM:
         {
           FAR struct local_conn_s *conn = psock->s_conn;
+
+#ifdef CONFIG_NET_LOCAL_RING
+          if (LOCAL_ISRING(conn))
+            {
+              local_ring_shutdown(conn, how);
+              return OK;
+            }
+#endif
+
           if (how & SHUT_RD)
             {
               if (conn->lc_infile.f_inode != NULL)
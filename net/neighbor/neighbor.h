@@ -31,6 +31,8 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/queue.h>
+#include <nuttx/seqlock.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -38,15 +40,58 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One Neighbor table entry with its hash chain and LRU list links */
+
+struct neighbor_node_s
+{
+  struct neighbor_entry_s     nn_entry;  /* The address mapping */
+  dq_entry_t                  nn_lru;    /* Least recently used first */
+  FAR struct neighbor_node_s *nn_hnext;  /* Next entry in the same bucket */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
- * this table.
+/* This is the Neighbor table.  The network should be locked when modifying
+ * this table; g_neighbor_seq lets neighbor_lookup() read it without the
+ * lock.  Entries are handed out in array order (g_neighbor_nused) and,
+ * once the table is full, recycled least recently used first.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern struct neighbor_node_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern FAR struct neighbor_node_s *
+  g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+extern dq_queue_t g_neighbor_lru;
+extern unsigned int g_neighbor_nused;
+extern seqcount_t g_neighbor_seq;
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_bucket
+ *
+ * Description:
+ *   Return the hash chain that holds the entries of an IPv6 address.
+ *
+ ****************************************************************************/
+
+static inline FAR struct neighbor_node_s **
+neighbor_bucket(FAR const uint16_t *ipaddr)
+{
+  uint32_t hash = (uint32_t)(ipaddr[4] ^ ipaddr[5]) << 16 |
+                  (uint32_t)(ipaddr[6] ^ ipaddr[7]);
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_neighbor_hash[(hash & 0xff) % CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+}
 
 /****************************************************************************
  * Public Function Prototypes
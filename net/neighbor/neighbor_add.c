@@ -33,6 +33,7 @@
 
 #include <net/if.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/neighbor.h>
@@ -65,78 +66,104 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_node_s *node;
+  FAR struct neighbor_node_s **pnode;
   uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
   bool    found = false;
+  bool    evict = false;
   bool    new_entry;
-  int     i;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
+  /* Find the matching entry, else an unused entry, else the least recently
+   * used entry.
    */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (node = *neighbor_bucket(ipaddr); node != NULL; node = node->nn_hnext)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (node->nn_entry.ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(node->nn_entry.ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
           found = true;
           break;
         }
+    }
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+  if (node == NULL)
+    {
+      if (g_neighbor_nused < CONFIG_NET_IPv6_NCONF_ENTRIES)
+        {
+          node = &g_neighbors[g_neighbor_nused++];
+        }
+      else
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          node  = container_of(dq_peek(&g_neighbor_lru),
+                               struct neighbor_node_s, nn_lru);
+          evict = true;
         }
     }
 
+  neighbor = &node->nn_entry;
+
   /* When overwite old entry, need to notify RTM_DELNEIGH */
 
-  if (!found && g_neighbors[oldest_ndx].ne_time != 0)
+  if (evict)
     {
-      netlink_neigh_notify(&g_neighbors[oldest_ndx], RTM_DELNEIGH,
-                           AF_INET6);
+      netlink_neigh_notify(neighbor, RTM_DELNEIGH, AF_INET6);
     }
 
   /* Need to notify when entry is not found or changes in table */
 
-  new_entry = !found || memcmp(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-                             g_neighbors[oldest_ndx].ne_addr.na_llsize) != 0;
+  new_entry = !found || memcmp(&neighbor->ne_addr.u, addr,
+                               neighbor->ne_addr.na_llsize) != 0;
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
+  /* Unlink a reused entry from the hash chain of its old address and from
+   * the LRU list; it is relinked as the most recently used entry below.
    */
 
-  g_neighbors[oldest_ndx].ne_dev  = dev;
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  write_seqbegin(&g_neighbor_seq);
+
+  if (found || evict)
+    {
+      for (pnode = neighbor_bucket(neighbor->ne_ipaddr); *pnode != NULL;
+           pnode = &(*pnode)->nn_hnext)
+        {
+          if (*pnode == node)
+            {
+              *pnode = node->nn_hnext;
+              break;
+            }
+        }
+
+      dq_rem(&node->nn_lru, &g_neighbor_lru);
+    }
+
+  neighbor->ne_dev  = dev;
+  neighbor->ne_time = clock_systime_ticks();
+  net_ipv6addr_copy(neighbor->ne_ipaddr, ipaddr);
+
+  neighbor->ne_addr.na_lltype = lltype;
+  neighbor->ne_addr.na_llsize = netdev_lladdrsize(dev);
+
+  memcpy(&neighbor->ne_addr.u, addr, neighbor->ne_addr.na_llsize);
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  node->nn_hnext = *neighbor_bucket(ipaddr);
+  *neighbor_bucket(ipaddr) = node;
+  dq_addlast(&node->nn_lru, &g_neighbor_lru);
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  write_seqend(&g_neighbor_seq);
 
   /* Notify the new entry */
 
   if (new_entry)
     {
-      netlink_neigh_notify(&g_neighbors[oldest_ndx], RTM_NEWNEIGH,
-                           AF_INET6);
+      netlink_neigh_notify(neighbor, RTM_NEWNEIGH, AF_INET6);
     }
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
 }
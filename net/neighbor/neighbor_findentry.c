@@ -53,11 +53,18 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_node_s *node;
+  unsigned int n = 0;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  /* The walk is bounded because neighbor_lookup() may run it while the
+   * table is being modified.
+   */
+
+  for (node = *neighbor_bucket(ipaddr);
+       node != NULL && n < CONFIG_NET_IPv6_NCONF_ENTRIES;
+       node = node->nn_hnext, n++)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &node->nn_entry;
 
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
@@ -32,11 +32,18 @@
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  The network should be locked when modifying
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+struct neighbor_node_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* Hash chains, LRU list and sequence counter indexing the table */
+
+FAR struct neighbor_node_s *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASH_SIZE];
+dq_queue_t g_neighbor_lru;
+unsigned int g_neighbor_nused;
+seqcount_t g_neighbor_seq = SEQCOUNT_INITIALIZER;
 
 /****************************************************************************
  * Public Functions
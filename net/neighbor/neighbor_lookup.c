@@ -30,6 +30,7 @@
 #include <debug.h>
 #include <string.h>
 
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/neighbor.h>
 
@@ -89,6 +90,38 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
   return 1;
 }
 
+/****************************************************************************
+ * Name: neighbor_lookup_table
+ *
+ * Description:
+ *   Look an IPv6 address up in the Neighbor table and copy out its link
+ *   layer address.
+ *
+ ****************************************************************************/
+
+static int neighbor_lookup_table(FAR const net_ipv6addr_t ipaddr,
+                                 FAR struct neighbor_addr_s *laddr)
+{
+  FAR struct neighbor_entry_s *neighbor;
+
+  neighbor = neighbor_findentry(ipaddr);
+  if (neighbor == NULL)
+    {
+      return -ENOENT;
+    }
+
+  /* Yes.. return the link layer address if the caller has provided a
+   * non-NULL address in 'laddr'.
+   */
+
+  if (laddr != NULL)
+    {
+      memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -115,27 +148,26 @@ static int neighbor_match(FAR struct net_driver_s *dev, FAR void *arg)
 int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
                     FAR struct neighbor_addr_s *laddr)
 {
-  FAR struct neighbor_entry_s *neighbor;
   struct neighbor_table_info_s info;
+  unsigned int seq;
+  int ret;
 
-  /* Check if the IPv6 address is already in the neighbor table. */
+  /* Check if the IPv6 address is already in the neighbor table.  This
+   * normally does not need the network lock; only if the table changed
+   * while it was being read is the lookup repeated with the network locked.
+   */
 
-  neighbor = neighbor_findentry(ipaddr);
-  if (neighbor != NULL)
+  seq = read_seqbegin(&g_neighbor_seq);
+  ret = neighbor_lookup_table(ipaddr, laddr);
+  if (read_seqretry(&g_neighbor_seq, seq))
     {
-      /* Yes.. return the link layer address if the caller has provided a
-       * non-NULL address in 'laddr'.
-       */
-
-      if (laddr != NULL)
-        {
-          memcpy(laddr, &neighbor->ne_addr, sizeof(*laddr));
-        }
-
-      /* Return success in any case meaning that a valid link layer
-       * address mapping is available for the IPv6 address.
-       */
+      net_lock();
+      ret = neighbor_lookup_table(ipaddr, laddr);
+      net_unlock();
+    }
 
+  if (ret == OK)
+    {
       return OK;
     }
 
@@ -147,7 +179,11 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
   net_ipv6addr_copy(info.ni_ipaddr, ipaddr);
   info.ni_laddr = laddr;
 
-  if (netdev_foreach(neighbor_match, &info) != 0)
+  net_lock();
+  ret = netdev_foreach(neighbor_match, &info);
+  net_unlock();
+
+  if (ret != 0)
     {
       return OK;
     }
@@ -72,7 +72,7 @@ unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
        nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
        i++)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i].nn_entry;
 
       /* An unused entry table entry will be nullified.  In particularly,
        * the Neighbor IP address will be all zero (i.e., the unspecified
@@ -26,6 +26,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/nuttx.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -50,11 +52,18 @@
 
 void neighbor_update(const net_ipv6addr_t ipaddr)
 {
-  struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_entry_s *neighbor;
+  FAR struct neighbor_node_s *node;
 
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
       neighbor->ne_time = clock_systime_ticks();
+
+      /* Make it the most recently used entry */
+
+      node = container_of(neighbor, struct neighbor_node_s, nn_entry);
+      dq_rem(&node->nn_lru, &g_neighbor_lru);
+      dq_addlast(&node->nn_lru, &g_neighbor_lru);
     }
 }
@@ -108,9 +108,24 @@ void netdev_iob_prepare_dynamic(FAR struct net_driver_s *dev, uint16_t size)
       return;
     }
 
-  /* alloc new iob for jumbo frame */
+#ifdef IOB_HAVE_CLASSES
+  /* Use a pre-allocated buffer of a large enough size class if any */
+
+  iob = iob_tryalloc_fit(size, false);
+  if (iob != NULL && IOB_BUFSIZE(iob) < size)
+    {
+      iob_free(iob);
+      iob = NULL;
+    }
+
+  if (iob == NULL)
+#endif
+    {
+      /* alloc new iob for jumbo frame */
+
+      iob = iob_alloc_dynamic(size);
+    }
 
-  iob = iob_alloc_dynamic(size);
   if (iob == NULL)
     {
       nerr("ERROR: Failed to allocate an I/O buffer.");
@@ -167,6 +182,10 @@ void netdev_iob_clear(FAR struct net_driver_s *dev)
   dev->d_iob = NULL;
   dev->d_buf = NULL;
   dev->d_len = 0;
+
+#ifdef CONFIG_NETDEV_GSO
+  dev->d_gso_size = 0;
+#endif
 }
 
 /****************************************************************************
@@ -191,6 +210,10 @@ void netdev_iob_release(FAR struct net_driver_s *dev)
     }
 
   dev->d_buf = NULL;
+
+#ifdef CONFIG_NETDEV_GSO
+  dev->d_gso_size = 0;
+#endif
 }
 
 /****************************************************************************
@@ -390,6 +390,32 @@ static uint32_t compute_hash(hashcal_algo_e hash_algo,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: netdev_rss_hash
+ *
+ * Description:
+ *   Compute the flow hash passed to drivers with SIOCNOTIFYRECVCPU.
+ *
+ * Input Parameters:
+ *   domain   - The layer 3 protocol, PF_INET/PF_INET6
+ *   src_addr - The source address
+ *   src_port - The source port
+ *   dst_addr - The destination address
+ *   dst_port - The destination port
+ *
+ * Returned Value:
+ *  The hash value
+ *
+ ****************************************************************************/
+
+uint32_t netdev_rss_hash(uint8_t domain,
+                         FAR const void *src_addr, uint16_t src_port,
+                         FAR const void *dst_addr, uint16_t dst_port)
+{
+  return compute_hash(HASHCAL_ALGO_CRC32, HASHCAL_TYPE_4TUPLE, domain,
+                      src_addr, src_port, dst_addr, dst_port);
+}
+
 /****************************************************************************
  * Name: netdev_notify_recvcpu
  *
@@ -417,16 +443,16 @@ void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
 {
   if (dev != NULL && dev->d_ioctl != NULL)
     {
-      uint32_t hash = compute_hash(HASHCAL_ALGO_CRC32,
-                                   HASHCAL_TYPE_4TUPLE,
-                                   domain,
-                                   src_addr, src_port,
-                                   dst_addr, dst_port);
+      uint32_t hash = netdev_rss_hash(domain, src_addr, src_port,
+                                      dst_addr, dst_port);
       struct netdev_rss_s arg;
       int ret;
 
       arg.cpu = cpu;
       arg.hash = hash;
+#if CONFIG_NETDEV_MAX_QUEUES > 1
+      arg.queue = -1;
+#endif
 
       ret = dev->d_ioctl(dev, SIOCNOTIFYRECVCPU,
                          (unsigned long)(uintptr_t)&arg);
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM_TRIE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The trie indexes the in-memory (RAM and ROM) routing tables only */
+
+#if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv4_ROMROUTE)
+#  define ROUTE_IPv4_LPM 1
+#endif
+
+#if defined(CONFIG_ROUTE_IPv6_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_ROMROUTE)
+#  define ROUTE_IPv6_LPM 1
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index.  Read-only routing tables
+ *   are indexed here; RAM routing tables are indexed as routes are added.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_lpmroute_add_ipv4 and net_lpmroute_add_ipv6
+ *
+ * Description:
+ *   Add a route that was just appended to the routing table to the index.
+ *
+ * Input Parameters:
+ *   route - The new routing table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+void net_lpmroute_add_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+void net_lpmroute_add_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_del_ipv4 and net_lpmroute_del_ipv6
+ *
+ * Description:
+ *   Remove a route that was just unlinked from the RAM routing table from
+ *   the index.
+ *
+ * Input Parameters:
+ *   route - The routing table entry being deleted
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_lpmroute_del_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_lpmroute_del_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Look up the route with the longest prefix that matches the target.
+ *
+ * Input Parameters:
+ *   target    - The IP address on a remote network to look up.
+ *   prefixlen - Only match prefixes longer than prefixlen.
+ *   router    - The location to return the router address.
+ *
+ * Returned Value:
+ *   OK if a route was found, -ENOENT if there is no matching route, or
+ *   -ENOSYS if the index cannot answer (e.g. because a route has a
+ *   non-contiguous netmask) and the routing table must be searched.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_lpmroute_ipv4(in_addr_t target, int8_t prefixlen,
+                      FAR in_addr_t *router);
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_lpmroute_ipv6(FAR const net_ipv6addr_t target, int16_t prefixlen,
+                      FAR net_ipv6addr_t router);
+#endif
+
+#endif /* CONFIG_ROUTE_LPM_TRIE */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -36,6 +36,7 @@
 
 #include "netlink/netlink.h"
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
@@ -113,6 +114,10 @@ static int net_del_ipv4route(FAR struct net_route_ipv4_s *route,
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM_TRIE
+      net_lpmroute_del_ipv4(route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET);
 
       /* And free the routing table entry by adding it to the free list */
@@ -171,6 +176,10 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_LPM_TRIE
+      net_lpmroute_del_ipv6(route);
+#endif
+
       netlink_route_notify(route, RTM_DELROUTE, AF_INET6);
 
       /* And free the routing table entry by adding it to the free list */
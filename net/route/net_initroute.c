@@ -28,6 +28,7 @@
 
 #include "route/ramroute.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #ifdef CONFIG_NET_ROUTE
@@ -59,6 +60,10 @@ void net_init_route(void)
 #if defined(CONFIG_ROUTE_IPv4_CACHEROUTE) || defined(CONFIG_ROUTE_IPv6_CACHEROUTE)
   net_init_cacheroute();
 #endif
+
+#ifdef CONFIG_ROUTE_LPM_TRIE
+  net_init_lpmroute();
+#endif
 }
 
 #endif /* CONFIG_NET_ROUTE */
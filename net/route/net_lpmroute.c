@@ -0,0 +1,709 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/romroute.h"
+#include "route/lpmroute.h"
+#include "route/route.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_ROUTE_LPM_TRIE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the largest key (prefix) kept in a trie node */
+
+#ifdef ROUTE_IPv6_LPM
+#  define LPM_KEYLEN 16
+#else
+#  define LPM_KEYLEN 4
+#endif
+
+/* A trie with N prefixes needs at most N route nodes and N - 1 branch
+ * nodes.
+ */
+
+#define LPM_NNODES(n) (2 * (n))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of a path-compressed binary trie.  Each node covers the first
+ * plen bits of key; its children extend that prefix with a 0 or a 1 bit.
+ * Branch nodes without a route always have two children.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *child[2]; /* Longer prefixes */
+  FAR void *route;                 /* Route for this exact prefix or NULL */
+  uint8_t plen;                    /* Prefix length in bits */
+  uint8_t key[LPM_KEYLEN];         /* Prefix in network order */
+};
+
+/* The index of one routing table */
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *root;     /* Shortest prefixes */
+  FAR struct lpm_node_s *free;     /* Unused nodes, linked by child[0] */
+  uint16_t nbypass;                /* Routes that the trie cannot hold */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+static struct lpm_trie_s g_ipv4_lpm;
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static struct lpm_node_s
+  g_ipv4_lpm_nodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv4_RAMROUTES)];
+#endif
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+static struct lpm_trie_s g_ipv6_lpm;
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static struct lpm_node_s
+  g_ipv6_lpm_nodes[LPM_NNODES(CONFIG_ROUTE_MAX_IPv6_RAMROUTES)];
+#endif
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_init
+ *
+ * Description:
+ *   Initialize an empty trie that allocates its nodes from the given pool.
+ *
+ ****************************************************************************/
+
+static void lpm_init(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *nodes, unsigned int nnodes)
+{
+  unsigned int i;
+
+  trie->root    = NULL;
+  trie->free    = NULL;
+  trie->nbypass = 0;
+
+  for (i = 0; i < nnodes; i++)
+    {
+      nodes[i].child[0] = trie->free;
+      trie->free        = &nodes[i];
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_alloc and lpm_free
+ *
+ * Description:
+ *   Take a node from, or return a node to, the free list of the trie.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_alloc(FAR struct lpm_trie_s *trie,
+                                        FAR const uint8_t *key,
+                                        uint8_t plen, FAR void *route)
+{
+  FAR struct lpm_node_s *node = trie->free;
+
+  if (node != NULL)
+    {
+      trie->free = node->child[0];
+      memset(node, 0, sizeof(struct lpm_node_s));
+
+      /* Keep only the prefix bits of the key */
+
+      memcpy(node->key, key, (plen + 7) >> 3);
+      if ((plen & 7) != 0)
+        {
+          node->key[plen >> 3] &= 0xff << (8 - (plen & 7));
+        }
+
+      node->plen  = plen;
+      node->route = route;
+    }
+
+  return node;
+}
+
+static void lpm_free(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *node)
+{
+  node->child[0] = trie->free;
+  trie->free     = node;
+}
+
+/****************************************************************************
+ * Name: lpm_bit
+ *
+ * Description:
+ *   Return bit number 'bit' of the key, counting from the MS bit.
+ *
+ ****************************************************************************/
+
+static inline int lpm_bit(FAR const uint8_t *key, unsigned int bit)
+{
+  return (key[bit >> 3] >> (7 - (bit & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits, up to maxbits, that two keys share.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *key1,
+                               FAR const uint8_t *key2,
+                               unsigned int maxbits)
+{
+  unsigned int bits;
+  uint8_t diff;
+
+  for (bits = 0; bits < maxbits; bits += 8)
+    {
+      diff = key1[bits >> 3] ^ key2[bits >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              bits++;
+            }
+
+          return bits < maxbits ? bits : maxbits;
+        }
+    }
+
+  return maxbits;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a prefix to the trie.  If the prefix is already present, the route
+ *   that was added first is kept, as a linear search of the routing table
+ *   would return that one.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                      uint8_t plen, FAR void *route)
+{
+  FAR struct lpm_node_s **pnode = &trie->root;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  FAR struct lpm_node_s *branch;
+  unsigned int common = 0;
+
+  /* Descend while the node prefix is a prefix of the new one */
+
+  while ((node = *pnode) != NULL)
+    {
+      common = lpm_common(key, node->key, MIN(plen, node->plen));
+      if (common != node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          if (node->route == NULL)
+            {
+              node->route = route;
+            }
+
+          return OK;
+        }
+
+      pnode = &node->child[lpm_bit(key, node->plen)];
+    }
+
+  leaf = lpm_alloc(trie, key, plen, route);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (node == NULL)
+    {
+      /* Empty slot, just hang the new prefix here */
+
+      *pnode = leaf;
+    }
+  else if (common == plen)
+    {
+      /* The new prefix is a prefix of the node: insert it above the node */
+
+      leaf->child[lpm_bit(node->key, plen)] = node;
+      *pnode = leaf;
+    }
+  else
+    {
+      /* The prefixes diverge at bit 'common': add a branch node there */
+
+      branch = lpm_alloc(trie, key, common, NULL);
+      if (branch == NULL)
+        {
+          lpm_free(trie, leaf);
+          return -ENOMEM;
+        }
+
+      branch->child[lpm_bit(key, common)]       = leaf;
+      branch->child[lpm_bit(node->key, common)] = node;
+      *pnode = branch;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove the route of a prefix from the trie.  If another route with the
+ *   same prefix remains in the routing table, it takes over the node.
+ *
+ ****************************************************************************/
+
+static void lpm_remove(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                       uint8_t plen, FAR void *route, FAR void *next)
+{
+  FAR struct lpm_node_s **pparent = NULL;
+  FAR struct lpm_node_s **pnode = &trie->root;
+  FAR struct lpm_node_s *parent;
+  FAR struct lpm_node_s *node;
+
+  while ((node = *pnode) != NULL && node->plen < plen)
+    {
+      if (lpm_common(key, node->key, node->plen) != node->plen)
+        {
+          return;
+        }
+
+      pparent = pnode;
+      pnode   = &node->child[lpm_bit(key, node->plen)];
+    }
+
+  /* Only the route the trie actually holds needs any work */
+
+  if (node == NULL || node->plen != plen || node->route != route ||
+      lpm_common(key, node->key, plen) != plen)
+    {
+      return;
+    }
+
+  node->route = next;
+  if (next != NULL || (node->child[0] != NULL && node->child[1] != NULL))
+    {
+      return;
+    }
+
+  /* The node has at most one child left, splice it out */
+
+  *pnode = node->child[0] != NULL ? node->child[0] : node->child[1];
+  lpm_free(trie, node);
+
+  /* If that left a branch node with a single child, splice it out too */
+
+  if (*pnode == NULL && pparent != NULL && (*pparent)->route == NULL)
+    {
+      parent   = *pparent;
+      *pparent = parent->child[0] != NULL ? parent->child[0] :
+                                            parent->child[1];
+      lpm_free(trie, parent);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the route with the longest prefix (longer than minplen) that
+ *   matches the key, or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR void *lpm_lookup(FAR struct lpm_trie_s *trie,
+                            FAR const uint8_t *key, unsigned int maxbits,
+                            int minplen)
+{
+  FAR struct lpm_node_s *node = trie->root;
+  FAR void *route = NULL;
+
+  while (node != NULL &&
+         lpm_common(key, node->key, node->plen) == node->plen)
+    {
+      if (node->route != NULL && node->plen > minplen)
+        {
+          route = node->route;
+        }
+
+      if (node->plen >= maxbits)
+        {
+          break;
+        }
+
+      node = node->child[lpm_bit(key, node->plen)];
+    }
+
+  return route;
+}
+
+/****************************************************************************
+ * Name: net_lpm_ipv4_prefix and net_lpm_ipv6_prefix
+ *
+ * Description:
+ *   Get the prefix length of a route.  Returns false if the netmask is not
+ *   contiguous, in which case the route cannot be held in the trie.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+static bool net_lpm_ipv4_prefix(FAR const struct net_route_ipv4_s *route,
+                                FAR uint8_t *plen)
+{
+  *plen = net_ipv4_mask2pref(route->netmask);
+  return route->netmask ==
+         (*plen == 0 ? 0 : HTONL(UINT32_MAX << (32 - *plen)));
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+static bool net_lpm_ipv6_prefix(FAR const struct net_route_ipv6_s *route,
+                                FAR uint8_t *plen)
+{
+  net_ipv6addr_t mask;
+
+  *plen = net_ipv6_mask2pref(route->netmask);
+  net_ipv6_pref2mask(mask, *plen);
+  return net_ipv6addr_cmp(mask, route->netmask);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_next_ipv4 and net_lpmroute_next_ipv6
+ *
+ * Description:
+ *   Find the first remaining RAM route with the same prefix as a route
+ *   being deleted.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static FAR struct net_route_ipv4_s *
+net_lpmroute_next_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  FAR struct net_route_ipv4_entry_s *entry;
+
+  for (entry = g_ipv4_routes.head; entry != NULL; entry = entry->flink)
+    {
+      if (&entry->entry != route &&
+          net_ipv4addr_cmp(entry->entry.netmask, route->netmask) &&
+          net_ipv4addr_maskcmp(entry->entry.target, route->target,
+                               route->netmask))
+        {
+          return &entry->entry;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static FAR struct net_route_ipv6_s *
+net_lpmroute_next_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  FAR struct net_route_ipv6_entry_s *entry;
+
+  for (entry = g_ipv6_routes.head; entry != NULL; entry = entry->flink)
+    {
+      if (&entry->entry != route &&
+          net_ipv6addr_cmp(entry->entry.netmask, route->netmask) &&
+          net_ipv6addr_maskcmp(entry->entry.target, route->target,
+                               route->netmask))
+        {
+          return &entry->entry;
+        }
+    }
+
+  return NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpm_build
+ *
+ * Description:
+ *   Index a read-only routing table.  The nodes are allocated once here;
+ *   if that fails the table is simply searched linearly.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_ROUTE_IPv4_ROMROUTE) || defined(CONFIG_ROUTE_IPv6_ROMROUTE)
+static bool net_lpm_build(FAR struct lpm_trie_s *trie, unsigned int nroutes)
+{
+  FAR struct lpm_node_s *nodes;
+
+  lpm_init(trie, NULL, 0);
+  if (nroutes == 0)
+    {
+      return true;
+    }
+
+  nodes = kmm_malloc(LPM_NNODES(nroutes) * sizeof(struct lpm_node_s));
+  if (nodes == NULL)
+    {
+      nerr("ERROR: Failed to allocate the route index\n");
+      trie->nbypass = 1;
+      return false;
+    }
+
+  lpm_init(trie, nodes, LPM_NNODES(nroutes));
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest prefix match index.  Read-only routing tables
+ *   are indexed here; RAM routing tables are indexed as routes are added.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#if defined(CONFIG_ROUTE_IPv4_ROMROUTE) || defined(CONFIG_ROUTE_IPv6_ROMROUTE)
+  unsigned int i;
+#endif
+
+#if defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+  lpm_init(&g_ipv4_lpm, g_ipv4_lpm_nodes, nitems(g_ipv4_lpm_nodes));
+#elif defined(CONFIG_ROUTE_IPv4_ROMROUTE)
+  if (net_lpm_build(&g_ipv4_lpm, g_ipv4_nroutes))
+    {
+      for (i = 0; i < g_ipv4_nroutes; i++)
+        {
+          net_lpmroute_add_ipv4(&g_ipv4_routes[i]);
+        }
+    }
+#endif
+
+#if defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+  lpm_init(&g_ipv6_lpm, g_ipv6_lpm_nodes, nitems(g_ipv6_lpm_nodes));
+#elif defined(CONFIG_ROUTE_IPv6_ROMROUTE)
+  if (net_lpm_build(&g_ipv6_lpm, g_ipv6_nroutes))
+    {
+      for (i = 0; i < g_ipv6_nroutes; i++)
+        {
+          net_lpmroute_add_ipv6(&g_ipv6_routes[i]);
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: net_lpmroute_add_ipv4 and net_lpmroute_add_ipv6
+ *
+ * Description:
+ *   Add a route that was just appended to the routing table to the index.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+void net_lpmroute_add_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  in_addr_t target = route->target;
+  uint8_t plen;
+
+  /* The pool is sized so that the insertion cannot fail, but if it ever
+   * does, fall back to searching the table rather than missing a route.
+   */
+
+  if (!net_lpm_ipv4_prefix(route, &plen) ||
+      lpm_insert(&g_ipv4_lpm, (FAR const uint8_t *)&target, plen,
+                 route) < 0)
+    {
+      g_ipv4_lpm.nbypass++;
+    }
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+void net_lpmroute_add_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  uint8_t plen;
+
+  if (!net_lpm_ipv6_prefix(route, &plen) ||
+      lpm_insert(&g_ipv6_lpm, (FAR const uint8_t *)route->target, plen,
+                 route) < 0)
+    {
+      g_ipv6_lpm.nbypass++;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_del_ipv4 and net_lpmroute_del_ipv6
+ *
+ * Description:
+ *   Remove a route that was just unlinked from the RAM routing table from
+ *   the index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_lpmroute_del_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  in_addr_t target = route->target;
+  uint8_t plen;
+
+  if (!net_lpm_ipv4_prefix(route, &plen))
+    {
+      DEBUGASSERT(g_ipv4_lpm.nbypass > 0);
+      g_ipv4_lpm.nbypass--;
+      return;
+    }
+
+  lpm_remove(&g_ipv4_lpm, (FAR const uint8_t *)&target, plen, route,
+             net_lpmroute_next_ipv4(route));
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_lpmroute_del_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  uint8_t plen;
+
+  if (!net_lpm_ipv6_prefix(route, &plen))
+    {
+      DEBUGASSERT(g_ipv6_lpm.nbypass > 0);
+      g_ipv6_lpm.nbypass--;
+      return;
+    }
+
+  lpm_remove(&g_ipv6_lpm, (FAR const uint8_t *)route->target, plen, route,
+             net_lpmroute_next_ipv6(route));
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4 and net_lpmroute_ipv6
+ *
+ * Description:
+ *   Look up the route with the longest prefix that matches the target.
+ *
+ ****************************************************************************/
+
+#ifdef ROUTE_IPv4_LPM
+int net_lpmroute_ipv4(in_addr_t target, int8_t prefixlen,
+                      FAR in_addr_t *router)
+{
+  FAR struct net_route_ipv4_s *route;
+  int ret = -ENOSYS;
+
+  net_lock();
+  if (g_ipv4_lpm.nbypass == 0)
+    {
+      route = lpm_lookup(&g_ipv4_lpm, (FAR const uint8_t *)&target, 32,
+                         prefixlen);
+      if (route != NULL)
+        {
+          net_ipv4addr_copy(*router, route->router);
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#ifdef ROUTE_IPv6_LPM
+int net_lpmroute_ipv6(FAR const net_ipv6addr_t target, int16_t prefixlen,
+                      FAR net_ipv6addr_t router)
+{
+  FAR struct net_route_ipv6_s *route;
+  int ret = -ENOSYS;
+
+  net_lock();
+  if (g_ipv6_lpm.nbypass == 0)
+    {
+      route = lpm_lookup(&g_ipv6_lpm, (FAR const uint8_t *)target, 128,
+                         prefixlen);
+      if (route != NULL)
+        {
+          net_ipv6addr_copy(router, route->router);
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_LPM_TRIE */
@@ -36,6 +36,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 #include "utils/utils.h"
 
@@ -264,6 +265,16 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router,
       return -ENOENT;
     }
 
+#ifdef ROUTE_IPv4_LPM
+  /* Look the route up in the prefix trie, unless the trie cannot answer */
+
+  ret = net_lpmroute_ipv4(target, prefixlen, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -358,6 +369,16 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router,
       return -ENOENT;
     }
 
+#ifdef ROUTE_IPv6_LPM
+  /* Look the route up in the prefix trie, unless the trie cannot answer */
+
+  ret = net_lpmroute_ipv6(target, prefixlen, router);
+  if (ret != -ENOSYS)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives a burst of messages from a socket.  This is
+ *   an internal OS interface.  It is functionally equivalent to recvmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of buffers in msgvec
+ *   flags    Receive flags
+ *   timeout  Limit on the time spent receiving, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received, msg_len of each
+ *   of them holds the number of bytes received.  A negated errno value is
+ *   returned if the first message could not be received (see comments with
+ *   recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  struct timespec deadline;
+  struct timespec now;
+  unsigned int i;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      clock_systime_timespec(&now);
+      clock_timespec_add(&now, timeout, &deadline);
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      /* Once one message is in, MSG_WAITFORONE only takes what is already
+       * queued.
+       */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      /* Like Linux, the timeout is only checked between messages */
+
+      if (timeout != NULL)
+        {
+          clock_systime_timespec(&now);
+          if (clock_timespec_compare(&now, &deadline) >= 0)
+            {
+              i++;
+              break;
+            }
+        }
+    }
+
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives several messages from a socket with a single call,
+ *   it is equivalent to calling recvmsg() for each of them.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   Buffers to receive the messages
+ *   vlen     The number of buffers in msgvec
+ *   flags    Receive flags, MSG_WAITFORONE sets MSG_DONTWAIT after the
+ *            first message has been received
+ *   timeout  Limit on the time spent receiving, or NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received in msgvec; msg_len
+ *   of each received message is updated with its number of bytes.  If the
+ *   first message could not be received, -1 is returned and errno is set as
+ *   for recvmsg().
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
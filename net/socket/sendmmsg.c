@@ -0,0 +1,190 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends a burst of messages to a socket.  This is an
+ *   internal OS interface.  It is functionally equivalent to sendmmsg()
+ *   except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Address families that can send a burst more cheaply than message by
+ *   message provide si_sendmmsg, the others get one si_sendmsg call per
+ *   message.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent, msg_len of each of
+ *   them holds the number of bytes sent.  A negated errno value is returned
+ *   if the first message could not be sent (see comments with sendmsg()
+ *   for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR struct msghdr *msg;
+  unsigned int i;
+  ssize_t ret = OK;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_conn == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (msgvec == NULL && vlen > 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Only pass on the leading messages that are well formed, as sendmsg()
+   * would reject the first one that is not.
+   */
+
+  for (i = 0; i < vlen; i++)
+    {
+      msg = &msgvec[i].msg_hdr;
+      if (msg->msg_iov == NULL || msg->msg_iov->iov_base == NULL)
+        {
+          break;
+        }
+    }
+
+  if (i == 0)
+    {
+      return vlen > 0 ? -EINVAL : 0;
+    }
+
+  vlen = i;
+
+  DEBUGASSERT(psock->s_sockif != NULL &&
+              psock->s_sockif->si_sendmsg != NULL);
+
+  if (psock->s_sockif->si_sendmmsg != NULL)
+    {
+      return psock->s_sockif->si_sendmmsg(psock, msgvec, vlen, flags);
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock->s_sockif->si_sendmsg(psock, &msgvec[i].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+    }
+
+  return i > 0 ? i : ret;
+}
+
+/****************************************************************************
+ * Function: sendmmsg
+ *
+ * Description:
+ *   The sendmmsg() call sends several messages on a socket with a single
+ *   call, it is equivalent to calling sendmsg() for each of them.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The messages to send
+ *   vlen     The number of messages in msgvec
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent from msgvec; msg_len
+ *   of each sent message is updated with its number of bytes sent.  If the
+ *   first message could not be sent, -1 is returned and errno is set as for
+ *   sendmsg().
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_sendmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+      fs_putfilep(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
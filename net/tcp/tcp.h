@@ -212,6 +212,8 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+  dq_entry_t hnode;       /* Link in the active connection hash table */
+  dq_entry_t lnode;       /* Link in the listener hash table */
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
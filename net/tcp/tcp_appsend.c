@@ -211,10 +211,16 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   else
     {
       /* The application cannot send more than what is allowed by the
-       * MSS (the minimum of the MSS and the available window).
+       * MSS (the minimum of the MSS and the available window), or by the
+       * GSO size of the device when it splits super-segments itself.
        */
 
+#ifdef CONFIG_NETDEV_GSO
+      DEBUGASSERT(dev->d_sndlen <= conn->mss ||
+                  dev->d_sndlen <= dev->d_gso_maxsize);
+#else
       DEBUGASSERT(dev->d_sndlen <= conn->mss);
+#endif
 
 #if !defined(CONFIG_NET_TCP_WRITE_BUFFERS) || defined(CONFIG_NET_SENDFILE)
 
@@ -58,6 +58,7 @@
 
 #include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -91,10 +92,92 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+/* The connected TCP connections again, hashed by local port, remote port
+ * and remote address so that an incoming segment finds its connection
+ * without walking g_active_tcp_connections.
+ */
+
+static dq_queue_t g_tcp_conn_hash[CONFIG_NET_TCP_HASH_SIZE];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hash
+ *
+ * Description:
+ *   Select the hash bucket of a connection from its ports and a 32-bit
+ *   summary of the remote address, all in network byte order.
+ *
+ ****************************************************************************/
+
+static inline unsigned int tcp_hash(uint16_t lport, uint16_t rport,
+                                    uint32_t raddr)
+{
+  uint32_t hash = raddr ^ ((uint32_t)lport << 16 | rport);
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+  return hash % CONFIG_NET_TCP_HASH_SIZE;
+}
+
+#ifdef CONFIG_NET_IPv6
+static inline uint32_t tcp_ipv6_fold(FAR const uint16_t *ipaddr)
+{
+  return ((uint32_t)(ipaddr[0] ^ ipaddr[2] ^ ipaddr[4] ^ ipaddr[6]) << 16) |
+         (ipaddr[1] ^ ipaddr[3] ^ ipaddr[5] ^ ipaddr[7]);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_bucket
+ *
+ * Description:
+ *   Return the hash bucket that holds the connection.  The address and
+ *   ports must not change while the connection is in the active list.
+ *
+ ****************************************************************************/
+
+static FAR dq_queue_t *tcp_conn_bucket(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return &g_tcp_conn_hash[tcp_hash(conn->lport, conn->rport,
+                                       conn->u.ipv4.raddr)];
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return &g_tcp_conn_hash[tcp_hash(conn->lport, conn->rport,
+                                       tcp_ipv6_fold(conn->u.ipv6.raddr))];
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_activate
+ *
+ * Description:
+ *   Put a connection whose addresses and ports are now complete into the
+ *   list of active connections and into the connection hash table.
+ *
+ ****************************************************************************/
+
+static void tcp_activate(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  dq_addlast(&conn->hnode, tcp_conn_bucket(conn));
+}
+
 /****************************************************************************
  * Name: tcp_listener
  *
@@ -186,15 +269,20 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *node;
+  unsigned int hash;
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
+  hash       = tcp_hash(tcp->destport, tcp->srcport, srcipaddr);
+  node       = dq_peek(&g_tcp_conn_hash[hash]);
 
-  while (conn)
+  for (; node != NULL; node = dq_next(node))
     {
+      conn = container_of(node, struct tcp_conn_s, hnode);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -219,19 +307,13 @@ static inline FAR struct tcp_conn_s *
            net_ipv4addr_cmp(destipaddr, conn->u.ipv4.laddr)) &&
           net_ipv4addr_cmp(srcipaddr, conn->u.ipv4.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
-
-      /* Look at the next active connection */
-
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -253,15 +335,21 @@ static inline FAR struct tcp_conn_s *
 {
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *node;
+  unsigned int hash;
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
+  hash       = tcp_hash(tcp->destport, tcp->srcport,
+                        tcp_ipv6_fold(ip->srcipaddr));
+  node       = dq_peek(&g_tcp_conn_hash[hash]);
 
-  while (conn)
+  for (; node != NULL; node = dq_next(node))
     {
+      conn = container_of(node, struct tcp_conn_s, hnode);
+
       /* Find an open connection matching the TCP input. The following
        * checks are performed:
        *
@@ -286,19 +374,13 @@ static inline FAR struct tcp_conn_s *
            net_ipv6addr_cmp(*destipaddr, conn->u.ipv6.laddr)) &&
           net_ipv6addr_cmp(*srcipaddr, conn->u.ipv6.raddr))
         {
-          /* Matching connection found.. break out of the loop and return a
-           * reference to it.
-           */
+          /* Matching connection found.. return a reference to it. */
 
-          break;
+          return conn;
         }
-
-      /* Look at the next active connection */
-
-      conn = (FAR struct tcp_conn_s *)conn->sconn.node.flink;
     }
 
-  return conn;
+  return NULL;
 }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -923,6 +1005,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->sconn.node, &g_active_tcp_connections);
+      dq_rem(&conn->hnode, tcp_conn_bucket(conn));
     }
 
   tcp_free_rx_buffers(conn);
@@ -1231,7 +1314,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+      tcp_activate(conn);
       tcp_update_retrantimer(conn, TCP_RTO);
     }
 
@@ -1542,7 +1625,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->sconn.node, &g_active_tcp_connections);
+  tcp_activate(conn);
   ret = OK;
 
 errout_with_lock:
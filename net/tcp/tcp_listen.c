@@ -50,6 +50,7 @@
 #include <stdbool.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 
@@ -61,14 +62,29 @@
  * Private Data
  ****************************************************************************/
 
-/* The tcp_listenports list all currently listening ports. */
+/* All currently listening connections, hashed by their local port */
 
-static FAR struct tcp_conn_s *tcp_listenports[CONFIG_NET_MAX_LISTENPORTS];
+static dq_queue_t g_tcp_listen_hash[CONFIG_NET_TCP_HASH_SIZE];
+static int g_tcp_nlisteners;
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_listen_bucket
+ *
+ * Description:
+ *   Return the listener hash bucket of a local port (in network order)
+ *
+ ****************************************************************************/
+
+static inline FAR dq_queue_t *tcp_listen_bucket(uint16_t portno)
+{
+  return &g_tcp_listen_hash[(portno ^ (portno >> 8)) %
+                            CONFIG_NET_TCP_HASH_SIZE];
+}
+
 /****************************************************************************
  * Name: tcp_findlistener
  *
@@ -89,21 +105,21 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
                                         uint16_t portno)
 #endif
 {
-  int ndx;
+  FAR dq_entry_t *node;
 
-  /* Examine each connection structure in each slot of the listener list */
+  /* Examine each listener that hashed to the same bucket as this port */
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  for (node = dq_peek(tcp_listen_bucket(portno)); node != NULL;
+       node = dq_next(node))
     {
-      /* Is this slot assigned?  If so, does the connection have the same
-       * local port number?
-       */
+      /* Does the connection have the same local port number? */
 
-      FAR struct tcp_conn_s *conn = tcp_listenports[ndx];
+      FAR struct tcp_conn_s *conn =
+        container_of(node, struct tcp_conn_s, lnode);
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
-      if (conn && conn->lport == portno && conn->domain == domain)
+      if (conn->lport == portno && conn->domain == domain)
 #else
-      if (conn && conn->lport == portno)
+      if (conn->lport == portno)
 #endif
         {
 #ifdef CONFIG_NET_IPv6
@@ -160,15 +176,18 @@ FAR struct tcp_conn_s *tcp_findlistener(FAR union ip_binding_u *uaddr,
 
 int tcp_unlisten(FAR struct tcp_conn_s *conn)
 {
-  int ndx;
+  FAR dq_queue_t *bucket;
+  FAR dq_entry_t *node;
   int ret = -EINVAL;
 
   net_lock();
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  bucket = tcp_listen_bucket(conn->lport);
+  for (node = dq_peek(bucket); node != NULL; node = dq_next(node))
     {
-      if (tcp_listenports[ndx] == conn)
+      if (node == &conn->lnode)
         {
-          tcp_listenports[ndx] = NULL;
+          dq_rem(node, bucket);
+          g_tcp_nlisteners--;
           ret = OK;
           break;
         }
@@ -191,7 +210,6 @@ int tcp_unlisten(FAR struct tcp_conn_s *conn)
 
 int tcp_listen(FAR struct tcp_conn_s *conn)
 {
-  int ndx;
   int ret;
 
   /* This must be done with network locked because the listener table
@@ -214,26 +232,19 @@ int tcp_listen(FAR struct tcp_conn_s *conn)
     }
   else
     {
-      /* Otherwise, save a reference to the connection structure in the
-       * "listener" list.
+      /* Otherwise, add the connection structure to the listener table,
+       * if the table is not already full.
        */
 
-      ret = -ENOBUFS; /* Assume failure */
-
-      /* Search all slots until an available slot is found */
-
-      for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+      if (g_tcp_nlisteners < CONFIG_NET_MAX_LISTENPORTS)
         {
-          /* Is the next slot available? */
-
-          if (!tcp_listenports[ndx])
-            {
-              /* Yes.. we found it */
-
-              tcp_listenports[ndx] = conn;
-              ret = OK;
-              break;
-            }
+          dq_addlast(&conn->lnode, tcp_listen_bucket(conn->lport));
+          g_tcp_nlisteners++;
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOBUFS;
         }
     }
 
@@ -181,6 +181,15 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 
   iob_update_pktlen(dev->d_iob, dev->d_len, false);
 
+#ifdef CONFIG_NETDEV_GSO
+  /* A payload beyond the MSS is a super-segment (see tcp_send_buffered.c)
+   * that the driver has to split back into MSS-sized segments.
+   */
+
+  dev->d_gso_size = dev->d_len > tcpip_hdrsize(conn) + conn->mss ?
+                    conn->mss : 0;
+#endif
+
   /* Calculate chk & build L3 header */
 
 #ifdef CONFIG_NET_IPv6
@@ -411,6 +411,37 @@ static int parse_sack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp,
 }
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
 
+/****************************************************************************
+ * Name: tcp_gso_size
+ *
+ * Description:
+ *   Return how much new data may go out in one packet: a single MSS, or a
+ *   multiple of it if the device splits super-segments itself (GSO).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_gso_size(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NETDEV_GSO
+  uint32_t size = dev->d_gso_maxsize;
+
+  /* Leave the driver enough IOBs to build the segments from the copy */
+
+  if (size > iob_navail(false) * CONFIG_IOB_BUFSIZE / 2)
+    {
+      size = iob_navail(false) * CONFIG_IOB_BUFSIZE / 2;
+    }
+
+  if (size > conn->mss)
+    {
+      return size - size % conn->mss;
+    }
+#endif
+
+  return conn->mss;
+}
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -1029,12 +1060,14 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       if (TCP_SEQ_LT(seq, snd_wnd_edge))
         {
           uint32_t remaining_snd_wnd;
+          uint32_t maxlen;
           int ret;
 
           sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
-          if (sndlen > conn->mss)
+          maxlen = tcp_gso_size(dev, conn);
+          if (sndlen > maxlen)
             {
-              sndlen = conn->mss;
+              sndlen = maxlen;
             }
 
           remaining_snd_wnd = TCP_SEQ_SUB(snd_wnd_edge, seq);
@@ -1193,6 +1226,20 @@ static uint32_t tcp_max_wrb_size(FAR struct tcp_conn_s *conn)
 
   size = 4 * mss;
 
+#ifdef CONFIG_NETDEV_GSO
+  /* or a full super-segment if the device does segmentation offload */
+
+  if (conn->dev != NULL && conn->dev->d_gso_maxsize > 0)
+    {
+      uint32_t gso = tcp_gso_size(conn->dev, conn);
+
+      if (size < gso)
+        {
+          size = gso;
+        }
+    }
+#endif
+
   /* but it should not hog too many IOB buffers */
 
   if (size > CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE / 2)
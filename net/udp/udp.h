@@ -33,6 +33,7 @@
 #include <sys/socket.h>
 
 #include <nuttx/queue.h>
+#include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/net.h>
@@ -132,9 +133,14 @@ struct udp_conn_s
   /* Read-ahead buffering.
    *
    *   readahead - An IOB chain where the UDP/IP read-ahead data is retained.
+   *   rdlock    - Protects readahead.  recvfrom() takes only this lock to
+   *               consume datagrams that are already queued, the network
+   *               lock is needed only when it has to wait for new data.
+   *               Lock order is network lock first, then rdlock.
    */
 
   FAR struct iob_s *readahead;   /* Read-ahead buffering */
+  mutex_t  rdlock;               /* Protects readahead */
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Write buffering
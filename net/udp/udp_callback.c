@@ -79,7 +79,15 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
   int offset;
 
 #if CONFIG_NET_RECV_BUFSIZE > 0
-  if (conn->readahead && conn->readahead->io_pktlen > conn->rcvbufs)
+  /* Only this path adds to the read-ahead chain and it runs with the
+   * network locked, so the chain can only shrink until the concat below.
+   */
+
+  nxmutex_lock(&conn->rdlock);
+  ret = conn->readahead && conn->readahead->io_pktlen > conn->rcvbufs;
+  nxmutex_unlock(&conn->rdlock);
+
+  if (ret)
     {
       netdev_iob_release(dev);
 #ifdef CONFIG_NET_STATISTICS
@@ -216,7 +224,9 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
 
   /* Concat the iob to readahead */
 
+  nxmutex_lock(&conn->rdlock);
   net_iob_concat(&conn->readahead, &iob);
+  nxmutex_unlock(&conn->rdlock);
 
 #ifdef CONFIG_NET_UDP_NOTIFIER
   ninfo("Buffered %d bytes\n", buflen);
@@ -656,6 +656,9 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 
       sq_init(&conn->write_q);
 #endif
+      conn->readahead   = NULL;
+      nxmutex_init(&conn->rdlock);
+
       /* Enqueue the connection into the active list */
 
       dq_addlast(&conn->sconn.node, &g_active_udp_connections);
@@ -693,7 +696,11 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   /* Release any read-ahead buffers attached to the connection, NULL is ok */
 
+  nxmutex_lock(&conn->rdlock);
   iob_free_chain(conn->readahead);
+  conn->readahead = NULL;
+  nxmutex_unlock(&conn->rdlock);
+  nxmutex_destroy(&conn->rdlock);
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Release any write buffers attached to the connection */
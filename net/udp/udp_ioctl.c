@@ -118,6 +118,7 @@ int udp_ioctl(FAR struct udp_conn_s *conn, int cmd, unsigned long arg)
   switch (cmd)
     {
       case FIONREAD:
+        nxmutex_lock(&conn->rdlock);
         iob = conn->readahead;
         if (iob)
           {
@@ -129,6 +130,8 @@ int udp_ioctl(FAR struct udp_conn_s *conn, int cmd, unsigned long arg)
           {
             *(FAR int *)((uintptr_t)arg) = 0;
           }
+
+        nxmutex_unlock(&conn->rdlock);
         break;
       case FIONSPACE:
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
@@ -144,7 +147,9 @@ int udp_ioctl(FAR struct udp_conn_s *conn, int cmd, unsigned long arg)
 #endif
         break;
       case FIOC_FILEPATH:
+        nxmutex_lock(&conn->rdlock);
         udp_path(conn, (FAR char *)(uintptr_t)arg, PATH_MAX);
+        nxmutex_unlock(&conn->rdlock);
         break;
       default:
         ret = -ENOTTY;
@@ -180,6 +180,7 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
 
   pstate->ir_recvlen = -1;
 
+  nxmutex_lock(&conn->rdlock);
   if ((iob = conn->readahead) != NULL)
     {
       int recvlen;
@@ -274,6 +275,8 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
             }
         }
     }
+
+  nxmutex_unlock(&conn->rdlock);
 }
 
 /****************************************************************************
@@ -631,6 +634,7 @@ static void udp_notify_recvcpu(FAR struct udp_conn_s *conn)
   cpu = this_cpu();
   if (cpu != conn->rcvcpu)
     {
+      net_lock();
       if (conn->domain == PF_INET)
         {
           netdev_notify_recvcpu(conn->dev, cpu, conn->domain,
@@ -645,6 +649,7 @@ static void udp_notify_recvcpu(FAR struct udp_conn_s *conn)
         }
 
       conn->rcvcpu = cpu;
+      net_unlock();
     }
 
   return;
@@ -685,14 +690,12 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   /* Perform the UDP recvfrom() operation */
 
-  /* Initialize the state structure.  This is done with the network locked
-   * because we don't want anything to happen until we are ready.
-   */
-
-  net_lock();
   udp_recvfrom_initialize(conn, msg, &state, flags);
 
-  /* Copy the read-ahead data from the packet */
+  /* Copy the read-ahead data from the packet.  This only needs the lock
+   * of the read-ahead chain, so a datagram that is already queued is
+   * received without contending for the network lock.
+   */
 
   udp_readahead(&state);
 
@@ -730,6 +733,19 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
 
   else if (state.ir_recvlen <= 0)
     {
+      /* Lock the network so that no input is processed until the callback
+       * is in place, and look again in case a datagram was queued before
+       * the lock was taken.
+       */
+
+      net_lock();
+      udp_readahead(&state);
+      ret = state.ir_recvlen;
+      if (ret > 0)
+        {
+          goto out_with_lock;
+        }
+
       /* Get the device that will handle the packet transfers.  This may be
        * NULL if the UDP socket is bound to INADDR_ANY.  In that case, no
        * NETDEV_DOWN notifications will be received.
@@ -769,11 +785,12 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR struct msghdr *msg,
         {
           ret = -EBUSY;
         }
+
+out_with_lock:
+      net_unlock();
     }
 
   udp_notify_recvcpu(conn);
-
-  net_unlock();
   udp_recvfrom_uninitialize(&state);
   return ret;
 }
@@ -27,6 +27,9 @@
 #include <nuttx/config.h>
 #ifdef CONFIG_NET
 
+#include <stdint.h>
+#include <sys/endian.h>
+
 #include "utils/utils.h"
 
 /****************************************************************************
@@ -34,85 +37,132 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: checksum
+ * Name: chksum_fold
  *
  * Description:
- *   Calculate the raw change sum over the memory region described by
- *   data and len.
+ *   Fold a wide one's complement accumulator down to 16 bits.
  *
- * Input Parameters:
- *   sum  - Partial calculations carried over from a previous call to
- *          chksum().  This should be zero on the first time that check
- *          sum is called.
- *   data - Beginning of the data to include in the checksum.
- *   len  - Length of the data to include in the checksum.
- *   odd  - the flag of the Calculated data sum
+ ****************************************************************************/
+
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 32) + (acc & 0xffffffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  acc = (acc >> 16) + (acc & 0xffff);
+  return (uint16_t)acc;
+}
+
+#ifndef CONFIG_NET_ARCH_CHKSUM
+/****************************************************************************
+ * Name: chksum_native
  *
- * Returned Value:
- *   The updated checksum value.
+ * Description:
+ *   Calculate the one's complement sum of the 16-bit words of a buffer
+ *   that starts on a 16-bit boundary, loading the words in host byte
+ *   order.  The body of the buffer is added 32 bits at a time into a 64-bit
+ *   accumulator, so no carry needs to be handled until the final fold.
+ *   The one's complement sum is byte order independent (RFC 1071), the
+ *   caller converts the result to network order once.
  *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
-uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
-                    uint16_t len, bool *odd)
+static uint16_t chksum_native(FAR const uint8_t *data, size_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *data32;
+  uint64_t acc = 0;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-  if (*odd == true)
+  data32 = (FAR const uint32_t *)data;
+  while (len >= 16)
     {
-      t = dataptr[0];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc    += data32[0];
+      acc    += data32[1];
+      acc    += data32[2];
+      acc    += data32[3];
+      data32 += 4;
+      len    -= 16;
+    }
 
-      dataptr += 1;
+  while (len >= 4)
+    {
+      acc += *data32++;
+      len -= 4;
     }
 
-  while (dataptr < last_byte)
+  data = (FAR const uint8_t *)data32;
+  if (len >= 2)
     {
-      /* At least two more bytes */
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  if (len > 0)
+    {
+      /* The trailing byte is the high byte of a zero padded word */
 
-      dataptr += 2;
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint16_t)data[0] << 8;
+#else
+      acc += data[0];
+#endif
     }
 
-  *odd = false;
+  return chksum_fold(acc);
+}
+
+/****************************************************************************
+ * Name: chksum_partial
+ *
+ * Description:
+ *   Calculate the raw checksum over the memory region described by data
+ *   and len, as if the region started on an even offset of the stream.
+ *
+ * Returned Value:
+ *   The checksum in host byte order.
+ *
+ ****************************************************************************/
+
+static uint16_t chksum_partial(FAR const uint8_t *data, size_t len)
+{
+  uint16_t sum;
 
-  if (dataptr == last_byte)
+  if (len == 0)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      return 0;
+    }
 
-      *odd = true;
+  if (((uintptr_t)data & 1) == 0)
+    {
+      sum = chksum_native(data, len);
+      return NTOHS(sum);
     }
 
-  /* Return sum in host byte order. */
+  /* The words after an unaligned leading byte are shifted by one byte,
+   * summing them natively and swapping the result compensates for that.
+   */
 
-  return sum;
+  sum = chksum_native(data + 1, len - 1);
+#ifdef CONFIG_ENDIAN_BIG
+  sum = __swap_uint16(sum);
+#endif
+
+  return chksum_fold((uint32_t)sum + ((uint16_t)data[0] << 8));
 }
+#endif /* CONFIG_NET_ARCH_CHKSUM */
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NET_ARCH_CHKSUM
 /****************************************************************************
  * Name: chksum
  *
@@ -134,9 +184,7 @@ uint16_t checksum(uint16_t sum, FAR const uint8_t *data,
 
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  bool odd = false;
-
-  return checksum(sum, data, len, &odd);
+  return chksum_fold((uint32_t)sum + chksum_partial(data, len));
 }
 
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -162,29 +210,36 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 #ifdef CONFIG_MM_IOB
 uint16_t chksum_iob(uint16_t sum, FAR struct iob_s *iob, uint16_t offset)
 {
-  /* Skip to the I/O buffer containing the data offset */
-
+  uint64_t acc = sum;
   bool odd = false;
 
+  /* Skip to the I/O buffer containing the data offset */
+
   while (iob != NULL && offset > iob->io_len)
     {
       offset -= iob->io_len;
       iob     = iob->io_flink;
     }
 
-  /* If the link pointer is not empty, loop to walk through all I/O buffer
-   * and accumulate the sum
+  /* Walk through all I/O buffers and accumulate the sum of each of them
+   * independently.  A buffer that starts on an odd offset of the stream
+   * contributes its byte swapped sum (RFC 1071), so no per-buffer odd byte
+   * fixup is needed.
    */
 
   while (iob != NULL)
     {
-      sum = checksum(sum, iob->io_data + iob->io_offset + offset,
-                      iob->io_len - offset, &odd);
-      iob = iob->io_flink;
+      uint16_t len = iob->io_len - offset;
+      uint16_t part = chksum(0, iob->io_data + iob->io_offset + offset,
+                             len);
+
+      acc   += odd ? __swap_uint16(part) : part;
+      odd   ^= (len & 1) != 0;
+      iob    = iob->io_flink;
       offset = 0;
     }
 
-  return sum;
+  return chksum_fold(acc);
 }
 #endif /* CONFIG_MM_IOB */
 
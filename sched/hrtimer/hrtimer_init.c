@@ -30,6 +30,7 @@ FAR __percpu_bss const struct hrtimer_ops_s *g_hrtimer_ops;
 static FAR __percpu_data struct hrtimer_s g_systick_timer = {
 	.expiration_time = 0,
 	.queue = NULL,
+	.index = -1,
 	.callback = systick_hrtimer_callback,
 };
 #define g_systick_timer this_cpu_var(g_systick_timer)
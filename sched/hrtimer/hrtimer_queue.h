@@ -34,8 +34,22 @@ static inline struct hrtimer_s *hrtimer_get_first(struct hrtimer_queue_s *queue)
 static inline_function void hrtimer_swap(struct hrtimer_s **a, struct hrtimer_s **b)
 {
 	struct hrtimer_s *tmp = *a;
+	int index = tmp->index;
+
 	*a = *b;
 	*b = tmp;
+
+	tmp->index = (*a)->index;
+	(*a)->index = index;
+}
+
+/* A timer is queued only if its cached slot still points back at it, so
+ * timers that were never initialized with an index are handled safely.
+ */
+
+static inline_function bool hrtimer_is_queued(struct hrtimer_queue_s *queue, struct hrtimer_s *hrtimer)
+{
+	return (hrtimer->index >= 0) && (hrtimer->index < queue->size) && (queue->heap[hrtimer->index] == hrtimer);
 }
 
 static inline_function int hrtimer_queue_down(struct hrtimer_queue_s *queue, int start)
@@ -97,22 +111,43 @@ static inline_function void hrtimer_pop(struct hrtimer_queue_s *queue)
 		return;
 	}
 
-	queue->heap[0] = queue->heap[--queue->size];
+	queue->heap[0]->index = -1;
+	if (--queue->size == 0) {
+		return;
+	}
+
+	queue->heap[0] = queue->heap[queue->size];
+	queue->heap[0]->index = 0;
 
 	(void)hrtimer_queue_down(queue, 0);
 }
 
+static inline_function void hrtimer_update(struct hrtimer_s *hrtimer)
+{
+	struct hrtimer_queue_s *queue = hrtimer->queue;
+	int current_position = hrtimer->index;
+
+	current_position = hrtimer_queue_down(queue, current_position);
+	(void)hrtimer_queue_up(queue, current_position);
+}
+
 static inline_function void hrtimer_insert(struct hrtimer_s *hrtimer)
 {
 	struct hrtimer_queue_s *queue = hrtimer->queue;
 	int current_position = 0;
 
+	if (hrtimer_is_queued(queue, hrtimer)) {
+		hrtimer_update(hrtimer);
+		return;
+	}
+
 	if (queue->size >= queue->queue_size) {
 		return;
 	}
 
 	current_position = queue->size++;
 	queue->heap[current_position] = hrtimer;
+	hrtimer->index = current_position;
 
 	(void)hrtimer_queue_up(queue, current_position);
 }
@@ -120,30 +155,21 @@ static inline_function void hrtimer_insert(struct hrtimer_s *hrtimer)
 static inline_function int hrtimer_remove(struct hrtimer_s *hrtimer)
 {
 	struct hrtimer_queue_s *queue = hrtimer->queue;
-	int current_position = 0;
-	int index = -1;
-	int i = 0;
+	int index = hrtimer->index;
 
-	if (queue->size == 0) {
+	if (!hrtimer_is_queued(queue, hrtimer)) {
 		return ERROR;
 	}
 
-	for (i = 0; i < queue->size; i++) {
-		if (queue->heap[i] == hrtimer) {
-			index = i;
-			break;
-		}
+	hrtimer->index = -1;
+	if (index == --queue->size) {
+		return OK;
 	}
 
-	if (index == -1) {
-		return ERROR;
-	}
+	queue->heap[index] = queue->heap[queue->size];
+	queue->heap[index]->index = index;
 
-	queue->heap[index] = queue->heap[--queue->size];
-	current_position = index;
-
-	current_position = hrtimer_queue_down(queue, current_position);
-	(void)hrtimer_queue_up(queue, current_position);
+	hrtimer_update(queue->heap[index]);
 
 	return OK;
-}
\ No newline at end of file
+}
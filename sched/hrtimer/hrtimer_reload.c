@@ -25,10 +25,14 @@
 void hrtimer_reload(struct hrtimer_s *hrtimer, hrtimer_tick_t time)
 {
 	struct hrtimer_queue_s *queue = hrtimer->queue;
+	struct hrtimer_s *first_hrtimer = hrtimer_get_first(queue);
 	hrtimer->expiration_time += time;
 
+	/* A still-queued timer is re-sifted from its cached slot in O(log n) */
+
 	hrtimer_insert(hrtimer);
-	if (hrtimer == hrtimer_get_first(queue)) {
-		hrtimer_set_expire(queue, hrtimer->expiration_time);
+	if ((hrtimer == first_hrtimer) || (hrtimer == hrtimer_get_first(queue))) {
+		first_hrtimer = hrtimer_get_first(queue);
+		hrtimer_set_expire(queue, first_hrtimer->expiration_time);
 	}
 }
\ No newline at end of file
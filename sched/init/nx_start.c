@@ -150,6 +150,18 @@ FAR __percpu_bss struct tcb_s *g_running_tasks[CONFIG_SMP_NCPUS];
 __percpu_bss dq_queue_t g_pendingtasks;
 #define g_pendingtasks this_cpu_var(g_pendingtasks)
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* Priority band indexes of g_readytorun and g_pendingtasks */
+
+#undef g_readytorun_index
+__percpu_bss struct tasklist_index_s g_readytorun_index;
+#define g_readytorun_index this_cpu_var(g_readytorun_index)
+
+#undef g_pendingtasks_index
+__percpu_bss struct tasklist_index_s g_pendingtasks_index;
+#define g_pendingtasks_index this_cpu_var(g_pendingtasks_index)
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 #undef g_waitingforsignal
@@ -453,7 +465,7 @@ static void idle_task_initialize(void)
 #else
       tasklist = TLIST_HEAD(tcb);
 #endif
-      dq_addfirst((FAR dq_entry_t *)tcb, tasklist);
+      nxsched_add_prioritized(tcb, tasklist);
 
       /* Mark the idle task as the running task */
 
@@ -681,6 +693,12 @@ void nx_start(void)
 
   irq_initialize();
 
+#ifdef CONFIG_BMP_CALL
+  /* Attach the cross-core function call doorbell of this CPU */
+
+  nxsched_bmp_call_initialize();
+#endif
+
   /* Initialize the watchdog facility (if included in the link) */
 
   wd_initialize();
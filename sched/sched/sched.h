@@ -31,6 +31,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <strings.h>
 #include <sched.h>
 
 #include <nuttx/arch.h>
@@ -80,6 +81,15 @@
 #define running_task() \
   (up_interrupt_context() ? g_running_tasks[this_cpu()] : this_task())
 
+/* Geometry of the ready-to-run priority index: one bit and one band tail
+ * per priority level.
+ */
+
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+#  define TLIST_NPRIORITIES      (SCHED_PRIORITY_MAX + 1)
+#  define TLIST_NPRIOWORDS       ((TLIST_NPRIORITIES + 31) / 32)
+#endif
+
 /* List attribute flags */
 
 #define TLIST_ATTR_PRIORITIZED   (1 << 0) /* Bit 0: List is prioritized */
@@ -132,6 +142,22 @@ struct tasklist_s
   uint8_t attr;          /* List attribute flags */
 };
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* This structure indexes a prioritized ready-to-run or pending task list.
+ * The list itself is unchanged, still ordered by descending priority, but
+ * the TCBs of each priority form a contiguous FIFO band whose last TCB is
+ * recorded here, and a bit is set for every non-empty band.  A new TCB is
+ * linked behind the tail of its own band or of the nearest higher band,
+ * which is found with ffs() on the bitmap instead of walking the list.
+ */
+
+struct tasklist_index_s
+{
+  uint32_t map[TLIST_NPRIOWORDS];          /* Bit set: band is not empty */
+  FAR struct tcb_s *tail[TLIST_NPRIORITIES]; /* Last TCB of each band */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -214,6 +240,16 @@ extern FAR struct tcb_s *g_running_tasks[CONFIG_SMP_NCPUS];
 extern dq_queue_t g_pendingtasks;
 #define g_pendingtasks this_cpu_var(g_pendingtasks)
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+/* Priority indexes of the g_readytorun and g_pendingtasks lists */
+
+extern struct tasklist_index_s g_readytorun_index;
+#define g_readytorun_index this_cpu_var(g_readytorun_index)
+
+extern struct tasklist_index_s g_pendingtasks_index;
+#define g_pendingtasks_index this_cpu_var(g_pendingtasks_index)
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 extern dq_queue_t g_waitingforsignal;
@@ -411,6 +447,10 @@ void nxsched_process_delivered(int cpu);
 #  define nxsched_select_cpu(a)     (0)
 #endif
 
+#ifdef CONFIG_BMP_CALL
+void nxsched_bmp_call_initialize(void);
+#endif
+
 #define nxsched_islocked_tcb(tcb)   ((tcb)->lockcount > 0)
 
 /* CPU load measurement support */
@@ -454,6 +494,102 @@ FAR char **nxsched_get_stackargs(FAR struct tcb_s *tcb);
  * Inline functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+static inline_function FAR struct tasklist_index_s *
+nxsched_list_index(DSEG dq_queue_t *list)
+{
+  if (list == list_readytorun())
+    {
+      return &g_readytorun_index;
+    }
+  else if (list == list_pendingtasks())
+    {
+      return &g_pendingtasks_index;
+    }
+
+  return NULL;
+}
+
+static inline_function void
+nxsched_index_clear(FAR struct tasklist_index_s *index)
+{
+  int i;
+
+  for (i = 0; i < TLIST_NPRIOWORDS; i++)
+    {
+      index->map[i] = 0;
+    }
+}
+
+/* Return the tail of the lowest non-empty band with a priority of at least
+ * 'priority', or NULL if there is none.
+ */
+
+static inline_function FAR struct tcb_s *
+nxsched_index_above(FAR struct tasklist_index_s *index, uint8_t priority)
+{
+  int word = priority >> 5;
+  uint32_t map;
+
+  map = index->map[word] & ~(((uint32_t)1 << (priority & 31)) - 1);
+  while (map == 0)
+    {
+      if (++word >= TLIST_NPRIOWORDS)
+        {
+          return NULL;
+        }
+
+      map = index->map[word];
+    }
+
+  return index->tail[(word << 5) + ffs(map) - 1];
+}
+
+/* Account for a TCB that was just linked into the list at 'priority' */
+
+static inline_function void
+nxsched_index_add(FAR struct tasklist_index_s *index,
+                  FAR struct tcb_s *tcb, uint8_t priority)
+{
+  uint32_t bit = (uint32_t)1 << (priority & 31);
+
+  /* The TCB becomes the band tail unless it was linked in front of other
+   * TCBs of the same priority (running task changing priority in place).
+   */
+
+  if ((index->map[priority >> 5] & bit) == 0 ||
+      tcb->flink == NULL ||
+      ((FAR struct tcb_s *)tcb->flink)->sched_priority != priority)
+    {
+      index->tail[priority] = tcb;
+      index->map[priority >> 5] |= bit;
+    }
+}
+
+/* Account for a TCB that is about to be unlinked from the list at
+ * 'priority'.
+ */
+
+static inline_function void
+nxsched_index_remove(FAR struct tasklist_index_s *index,
+                     FAR struct tcb_s *tcb, uint8_t priority)
+{
+  FAR struct tcb_s *prev = tcb->blink;
+
+  if (index->tail[priority] == tcb)
+    {
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          index->tail[priority] = prev;
+        }
+      else
+        {
+          index->map[priority >> 5] &= ~((uint32_t)1 << (priority & 31));
+        }
+    }
+}
+#endif
+
 static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
                                                     DSEG dq_queue_t *list)
 {
@@ -461,11 +597,51 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
   FAR struct tcb_s *prev;
   uint8_t sched_priority = tcb->sched_priority;
   bool ret = false;
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  FAR struct tasklist_index_s *index = nxsched_list_index(list);
+#endif
 
   /* Lets do a sanity check before we get started. */
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  if (index != NULL)
+    {
+      /* Link the TCB behind the tail of the nearest band of the same or
+       * higher priority, or at the head of the list if there is none.
+       */
+
+      prev = nxsched_index_above(index, sched_priority);
+      next = prev != NULL ? prev->flink : (FAR struct tcb_s *)list->head;
+
+      tcb->flink = next;
+      tcb->blink = prev;
+
+      if (prev == NULL)
+        {
+          list->head = (FAR dq_entry_t *)tcb;
+          ret = true;
+        }
+      else
+        {
+          prev->flink = tcb;
+        }
+
+      if (next == NULL)
+        {
+          list->tail = (FAR dq_entry_t *)tcb;
+        }
+      else
+        {
+          next->blink = tcb;
+        }
+
+      nxsched_index_add(index, tcb, sched_priority);
+      return ret;
+    }
+#endif
+
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
    */
@@ -533,6 +709,51 @@ static inline_function bool nxsched_add_prioritized(FAR struct tcb_s *tcb,
   return ret;
 }
 
+/* Remove a TCB from a prioritized task list */
+
+static inline_function void nxsched_rem_prioritized(FAR struct tcb_s *tcb,
+                                                    DSEG dq_queue_t *list)
+{
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  FAR struct tasklist_index_s *index = nxsched_list_index(list);
+
+  if (index != NULL)
+    {
+      nxsched_index_remove(index, tcb, tcb->sched_priority);
+    }
+#endif
+
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+/* Change the priority of a TCB without moving it in its task list.  The
+ * caller must make sure that the list stays ordered by priority.
+ */
+
+static inline_function void nxsched_update_priority(FAR struct tcb_s *tcb,
+                                                    uint8_t sched_priority)
+{
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  FAR struct tasklist_index_s *index;
+
+#  ifdef CONFIG_SMP
+  index = nxsched_list_index(TLIST_HEAD(tcb, tcb->cpu));
+#  else
+  index = nxsched_list_index(TLIST_HEAD(tcb));
+#  endif
+
+  if (index != NULL)
+    {
+      nxsched_index_remove(index, tcb, tcb->sched_priority);
+      tcb->sched_priority = sched_priority;
+      nxsched_index_add(index, tcb, sched_priority);
+      return;
+    }
+#endif
+
+  tcb->sched_priority = sched_priority;
+}
+
 #  ifdef CONFIG_SMP
 static inline_function int nxsched_select_cpu(cpu_set_t affinity)
 {
@@ -0,0 +1,525 @@
+/****************************************************************************
+ * sched/sched/sched_bmp.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <sched.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/atomic.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_BMP_CALL_RING_SIZE & (CONFIG_BMP_CALL_RING_SIZE - 1)) != 0
+#  error CONFIG_BMP_CALL_RING_SIZE must be a power of two
+#endif
+
+#define BMP_RING_MASK               (CONFIG_BMP_CALL_RING_SIZE - 1)
+
+/* Message types carried by the call rings */
+
+#define BMP_MSG_CALL                0
+#define BMP_MSG_MBOX                1
+
+#define MMAP_SHARE_VAR_INIT_SECTION         __attribute__((section(".data.Share.VAR_INIT"))) __attribute__ ((aligned (64)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The cookie lives on the stack of a waiting caller.  It is only touched
+ * by the calling CPU: the reply carries the pointer back untouched.
+ */
+
+struct bmp_call_cookie_s
+{
+  sem_t                         sem;
+  int                           result;
+};
+
+struct bmp_msg_s
+{
+  int                           type;     /* BMP_MSG_* */
+  int                           value;    /* Mailbox channel or call result */
+  nxsched_bmp_call_t            func;     /* Function to call */
+  FAR void                     *arg;      /* Function args or mailbox msg */
+  FAR struct bmp_call_cookie_s *cookie;   /* Waiter on the calling CPU */
+};
+
+/* Single-producer/single-consumer ring.  head is only written by the
+ * producer and tail only by the consumer, each on its own cache line.
+ */
+
+struct bmp_ring_s
+{
+  atomic_uint                   head aligned_data(64);
+  atomic_uint                   tail aligned_data(64);
+  struct bmp_msg_s              msg[CONFIG_BMP_CALL_RING_SIZE];
+};
+
+struct bmp_mbox_s
+{
+  nxsched_bmp_mbox_t            handler;
+  FAR void                     *arg;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Rings shared by all CPUs, indexed by [receiver][sender].  Calls and
+ * mailbox messages travel in g_bmp_call_ring, results of synchronous
+ * calls come back in g_bmp_done_ring.
+ */
+
+MMAP_SHARE_VAR_INIT_SECTION
+static struct bmp_ring_s
+g_bmp_call_ring[CONFIG_BMP_NCPUS][CONFIG_BMP_NCPUS];
+MMAP_SHARE_VAR_INIT_SECTION
+static struct bmp_ring_s
+g_bmp_done_ring[CONFIG_BMP_NCPUS][CONFIG_BMP_NCPUS];
+
+/* Non-zero while a doorbell is outstanding for the CPU */
+
+MMAP_SHARE_VAR_INIT_SECTION
+static atomic_int g_bmp_pending[CONFIG_BMP_NCPUS];
+
+/* Free slots in the done ring from each CPU back to this one.  A waiting
+ * caller takes a slot before posting the call, so the callee never has to
+ * wait for room to post the result.
+ */
+
+static __percpu_bss sem_t g_bmp_credit[CONFIG_BMP_NCPUS];
+static __percpu_bss struct bmp_mbox_s g_bmp_mbox[CONFIG_BMP_CALL_NMBOX];
+
+#define g_bmp_credit this_cpu_var(g_bmp_credit)
+#define g_bmp_mbox   this_cpu_var(g_bmp_mbox)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_bmp_push
+ *
+ * Description:
+ *   Append a message to a ring.  Must only be called by the ring producer.
+ *
+ * Returned Value:
+ *   true on success; false if the ring is full.
+ *
+ ****************************************************************************/
+
+static bool nxsched_bmp_push(FAR struct bmp_ring_s *ring,
+                             FAR const struct bmp_msg_s *msg)
+{
+  unsigned int head = atomic_load_explicit(&ring->head,
+                                           memory_order_relaxed);
+  unsigned int tail = atomic_load_explicit(&ring->tail,
+                                           memory_order_acquire);
+
+  if (head - tail >= CONFIG_BMP_CALL_RING_SIZE)
+    {
+      return false;
+    }
+
+  ring->msg[head & BMP_RING_MASK] = *msg;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_pop
+ *
+ * Description:
+ *   Remove the oldest message from a ring.  Must only be called by the
+ *   ring consumer.
+ *
+ * Returned Value:
+ *   true on success; false if the ring is empty.
+ *
+ ****************************************************************************/
+
+static bool nxsched_bmp_pop(FAR struct bmp_ring_s *ring,
+                            FAR struct bmp_msg_s *msg)
+{
+  unsigned int tail = atomic_load_explicit(&ring->tail,
+                                           memory_order_relaxed);
+  unsigned int head = atomic_load_explicit(&ring->head,
+                                           memory_order_acquire);
+
+  if (tail == head)
+    {
+      return false;
+    }
+
+  *msg = ring->msg[tail & BMP_RING_MASK];
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_doorbell
+ *
+ * Description:
+ *   Interrupt the target CPU unless a doorbell is already outstanding.
+ *   Messages queued before the target drains its rings share one
+ *   interrupt.
+ *
+ ****************************************************************************/
+
+static void nxsched_bmp_doorbell(int cpu)
+{
+  if (atomic_exchange_explicit(&g_bmp_pending[cpu], 1,
+                               memory_order_seq_cst) == 0)
+    {
+      up_trigger_irq(CONFIG_BMP_CALL_IRQ, (cpu_set_t)1 << cpu);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_send
+ *
+ * Description:
+ *   Queue a message for the target CPU and ring its doorbell.  Local
+ *   senders are serialized by the critical section so that each ring keeps
+ *   a single producer.
+ *
+ ****************************************************************************/
+
+static int nxsched_bmp_send(int cpu, FAR const struct bmp_msg_s *msg)
+{
+  FAR struct bmp_ring_s *ring = &g_bmp_call_ring[cpu][up_cpu_index()];
+  irqstate_t flags;
+  bool sent;
+
+  for (; ; )
+    {
+      flags = enter_critical_section();
+      sent = nxsched_bmp_push(ring, msg);
+      leave_critical_section(flags);
+
+      if (sent)
+        {
+          break;
+        }
+
+      /* The ring is full.  The receiver drains it from its doorbell
+       * handler without ever waiting on us, so a task may simply retry.
+       */
+
+      if (up_interrupt_context())
+        {
+          return -EAGAIN;
+        }
+
+      sched_yield();
+    }
+
+  nxsched_bmp_doorbell(cpu);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_bmp_call_initialize
+ *
+ * Description:
+ *   Initialize the BMP function call support of the current CPU.  Called
+ *   by each CPU from nx_start().
+ *
+ ****************************************************************************/
+
+void nxsched_bmp_call_initialize(void)
+{
+  int cpu = up_cpu_index();
+  int i;
+
+  for (i = 0; i < CONFIG_BMP_NCPUS; i++)
+    {
+      nxsem_init(&g_bmp_credit[i], 0, CONFIG_BMP_CALL_RING_SIZE);
+    }
+
+  irq_attach(CONFIG_BMP_CALL_IRQ, nxsched_bmp_call_handler, NULL);
+  up_enable_irq(CONFIG_BMP_CALL_IRQ);
+
+  /* Other CPUs may already have queued messages and rung a doorbell that
+   * was lost before the handler was attached.  Kick ourselves once.
+   */
+
+  atomic_store_explicit(&g_bmp_pending[cpu], 1, memory_order_seq_cst);
+  up_trigger_irq(CONFIG_BMP_CALL_IRQ, (cpu_set_t)1 << cpu);
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_call_handler
+ *
+ * Description:
+ *   BMP function call doorbell handler
+ *
+ * Input Parameters:
+ *   irq     - Interrupt id
+ *   context - Regs context before irq
+ *   arg     - Interrupt arg
+ *
+ * Returned Value:
+ *   Result
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_call_handler(int irq, FAR void *context,
+                             FAR void *arg)
+{
+  struct bmp_msg_s msg;
+  cpu_set_t doorbell = 0;
+  int me = up_cpu_index();
+  int cpu;
+  int ret;
+
+  /* Re-arm the doorbell before looking at the rings: anything queued from
+   * now on rings it again.
+   */
+
+  atomic_exchange_explicit(&g_bmp_pending[me], 0, memory_order_seq_cst);
+
+  for (cpu = 0; cpu < CONFIG_BMP_NCPUS; cpu++)
+    {
+      if (cpu == me)
+        {
+          continue;
+        }
+
+      /* Results of our own calls first, they return credits */
+
+      while (nxsched_bmp_pop(&g_bmp_done_ring[me][cpu], &msg))
+        {
+          msg.cookie->result = msg.value;
+          nxsem_post(&msg.cookie->sem);
+          nxsem_post(&g_bmp_credit[cpu]);
+        }
+
+      while (nxsched_bmp_pop(&g_bmp_call_ring[me][cpu], &msg))
+        {
+          if (msg.type == BMP_MSG_MBOX)
+            {
+              FAR struct bmp_mbox_s *mbox = &g_bmp_mbox[msg.value];
+
+              if (mbox->handler != NULL)
+                {
+                  mbox->handler(cpu, msg.arg, mbox->arg);
+                }
+
+              continue;
+            }
+
+          ret = msg.func(msg.arg);
+          if (msg.cookie != NULL)
+            {
+              msg.value = ret;
+              if (!nxsched_bmp_push(&g_bmp_done_ring[cpu][me], &msg))
+                {
+                  /* Cannot happen, the caller reserved this slot */
+
+                  DEBUGPANIC();
+                }
+
+              doorbell |= (cpu_set_t)1 << cpu;
+            }
+        }
+    }
+
+  for (cpu = 0; doorbell != 0; cpu++, doorbell >>= 1)
+    {
+      if ((doorbell & 1) != 0)
+        {
+          nxsched_bmp_doorbell(cpu);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_call
+ *
+ * Description:
+ *   Call function on another BMP processor
+ *
+ * Input Parameters:
+ *   cpu  - Target cpu id
+ *   func - Function
+ *   arg  - Function args
+ *   wait - Wait for the function to return or just post the call
+ *
+ * Returned Value:
+ *   Result
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_call(int cpu, nxsched_bmp_call_t func, FAR void *arg,
+                     bool wait)
+{
+  struct bmp_call_cookie_s cookie;
+  struct bmp_msg_s msg;
+  int ret;
+
+  DEBUGASSERT(cpu >= 0 && cpu < CONFIG_BMP_NCPUS && func != NULL);
+
+  /* Cannot wait in interrupt context. */
+
+  DEBUGASSERT(!(wait && up_interrupt_context()));
+
+  if (cpu == up_cpu_index())
+    {
+      ret = func(arg);
+      return wait ? ret : OK;
+    }
+
+  msg.type   = BMP_MSG_CALL;
+  msg.value  = 0;
+  msg.func   = func;
+  msg.arg    = arg;
+  msg.cookie = NULL;
+
+  if (wait)
+    {
+      /* Reserve room for the result before posting the call */
+
+      ret = nxsem_wait_uninterruptible(&g_bmp_credit[cpu]);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      nxsem_init(&cookie.sem, 0, 0);
+      cookie.result = OK;
+      msg.cookie = &cookie;
+    }
+
+  ret = nxsched_bmp_send(cpu, &msg);
+  if (wait)
+    {
+      if (ret >= 0)
+        {
+          ret = nxsem_wait_uninterruptible(&cookie.sem);
+          if (ret >= 0)
+            {
+              ret = cookie.result;
+            }
+        }
+      else
+        {
+          nxsem_post(&g_bmp_credit[cpu]);
+        }
+
+      nxsem_destroy(&cookie.sem);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_mbox_bind
+ *
+ * Description:
+ *   Bind a handler to a mailbox channel of this processor
+ *
+ * Input Parameters:
+ *   chan    - Mailbox channel
+ *   handler - Message handler, NULL to unbind
+ *   arg     - Handler private data
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_mbox_bind(int chan, nxsched_bmp_mbox_t handler,
+                          FAR void *arg)
+{
+  irqstate_t flags;
+
+  if (chan < 0 || chan >= CONFIG_BMP_CALL_NMBOX)
+    {
+      return -EINVAL;
+    }
+
+  /* The doorbell handler runs on this CPU only */
+
+  flags = enter_critical_section();
+  g_bmp_mbox[chan].handler = handler;
+  g_bmp_mbox[chan].arg     = arg;
+  leave_critical_section(flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxsched_bmp_mbox_send
+ *
+ * Description:
+ *   Send a message to a mailbox channel of another processor
+ *
+ * Input Parameters:
+ *   cpu  - Target cpu id
+ *   chan - Mailbox channel on the target cpu
+ *   msg  - Message
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int nxsched_bmp_mbox_send(int cpu, int chan, FAR void *msg)
+{
+  struct bmp_msg_s mmsg;
+
+  if (cpu < 0 || cpu >= CONFIG_BMP_NCPUS || cpu == up_cpu_index() ||
+      chan < 0 || chan >= CONFIG_BMP_CALL_NMBOX)
+    {
+      return -EINVAL;
+    }
+
+  mmsg.type   = BMP_MSG_MBOX;
+  mmsg.value  = chan;
+  mmsg.func   = NULL;
+  mmsg.arg    = msg;
+  mmsg.cookie = NULL;
+
+  return nxsched_bmp_send(cpu, &mmsg);
+}
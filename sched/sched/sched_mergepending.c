@@ -75,9 +75,11 @@
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
+#ifndef CONFIG_SCHED_READYTORUN_BITMAP
   FAR struct tcb_s *pnext;
-  FAR struct tcb_s *rtcb;
   FAR struct tcb_s *rprev;
+#endif
+  FAR struct tcb_s *rtcb;
   bool ret = false;
 
   /* Initialize the inner search loop */
@@ -91,6 +93,31 @@ bool nxsched_merge_pending(void)
 
   if (rtcb->lockcount == 0)
     {
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+      /* Move the pending TCBs one by one, each insertion into the indexed
+       * ready-to-run list takes constant time.
+       */
+
+      while ((ptcb = (FAR struct tcb_s *)
+                     dq_peek(list_pendingtasks())) != NULL)
+        {
+          nxsched_rem_prioritized(ptcb, list_pendingtasks());
+
+          if (nxsched_add_prioritized(ptcb, list_readytorun()))
+            {
+              /* ptcb was added at the head of the ready-to-run list */
+
+              ptcb->flink->task_state = TSTATE_TASK_READYTORUN;
+              ptcb->task_state        = TSTATE_TASK_RUNNING;
+              up_update_task(ptcb);
+              ret                     = true;
+            }
+          else
+            {
+              ptcb->task_state        = TSTATE_TASK_READYTORUN;
+            }
+        }
+#else
       for (ptcb = (FAR struct tcb_s *)list_pendingtasks()->head;
            ptcb;
            ptcb = pnext)
@@ -157,6 +184,7 @@ bool nxsched_merge_pending(void)
 
       list_pendingtasks()->head = NULL;
       list_pendingtasks()->tail = NULL;
+#endif
     }
 
   return ret;
@@ -228,7 +256,8 @@ bool nxsched_merge_pending(void)
         {
           /* Remove the task from the pending task list */
 
-          tcb = (FAR struct tcb_s *)dq_remfirst(list_pendingtasks());
+          tcb = ptcb;
+          nxsched_rem_prioritized(tcb, list_pendingtasks());
 
           /* Add the pending task to the correct ready-to-run list. */
 
@@ -80,6 +80,13 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
   dq_move(list1, &clone);
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  if (nxsched_list_index(list1) != NULL)
+    {
+      nxsched_index_clear(nxsched_list_index(list1));
+    }
+#endif
+
   /* Get the TCB at the head of list1 */
 
   tcb1 = (FAR struct tcb_s *)dq_peek(&clone);
@@ -102,6 +109,22 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       tmp->task_state = task_state;
     }
 
+#ifdef CONFIG_SCHED_READYTORUN_BITMAP
+  /* An indexed list2 takes each TCB in constant time, so there is no need
+   * to walk it in step with list1.
+   */
+
+  if (nxsched_list_index(list2) != NULL)
+    {
+      while ((tmp = (FAR struct tcb_s *)dq_remfirst(&clone)) != NULL)
+        {
+          nxsched_add_prioritized(tmp, list2);
+        }
+
+      return;
+    }
+#endif
+
   /* Get the head of list2 */
 
   tcb2 = (FAR struct tcb_s *)dq_peek(list2);
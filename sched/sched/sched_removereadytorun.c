@@ -93,7 +93,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+  nxsched_rem_prioritized(rtcb, tasklist);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -253,7 +253,7 @@ void nxsched_remove_running(FAR struct tcb_s *tcb)
        * list and add to the head of the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtrtcb, &g_readytorun);
+      nxsched_rem_prioritized(rtrtcb, &g_readytorun);
       dq_addfirst_nonempty((FAR dq_entry_t *)rtrtcb, tasklist);
 
       rtrtcb->cpu = cpu;
@@ -318,7 +318,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *tcb)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      nxsched_rem_prioritized(tcb, tasklist);
 
       /* Since the TCB is no longer in any list, it is now invalid */
 
@@ -217,7 +217,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
           /* Change the task priority */
 
-          tcb->sched_priority = (uint8_t)sched_priority;
+          nxsched_update_priority(tcb, (uint8_t)sched_priority);
         }
       else
         {
@@ -264,7 +264,7 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
     {
       /* Change the task priority */
 
-      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_update_priority(tcb, (uint8_t)sched_priority);
     }
 }
 
@@ -329,7 +329,7 @@ static inline void nxsched_blocked_setpriority(FAR struct tcb_s *tcb,
     {
       /* Remove the TCB from the prioritized task list */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      nxsched_rem_prioritized(tcb, tasklist);
 
       /* Change the task priority */
 
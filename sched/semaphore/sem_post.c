@@ -80,6 +80,17 @@ int nxsem_post(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL);
 
+#ifdef CONFIG_SEM_FAST_PATH
+  /* Release a semaphore that nobody waits for without entering the
+   * critical section.
+   */
+
+  if (nxsem_fast_capable(sem) && nxsem_fast_post(sem))
+    {
+      return OK;
+    }
+#endif
+
   /* The following operations must be performed with interrupts
    * disabled because sem_post() may be called from an interrupt
    * handler.
@@ -87,11 +98,9 @@ int nxsem_post(FAR sem_t *sem)
 
   flags = enter_critical_section();
 
-  sem_count = sem->semcount;
-
   /* Check the maximum allowable value */
 
-  if (sem_count >= SEM_VALUE_MAX)
+  if (sem->semcount >= SEM_VALUE_MAX)
     {
       leave_critical_section(flags);
       return -EOVERFLOW;
@@ -115,8 +124,7 @@ int nxsem_post(FAR sem_t *sem)
    */
 
   nxsem_release_holder(sem);
-  sem_count++;
-  sem->semcount = sem_count;
+  sem_count = nxsem_count_inc(sem) + 1;
 
 #if defined(CONFIG_PRIORITY_INHERITANCE) || defined(CONFIG_PRIORITY_PROTECT)
   /* Don't let any unblocked tasks run until we complete any priority
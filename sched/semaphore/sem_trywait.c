@@ -78,6 +78,18 @@ int nxsem_trywait(FAR sem_t *sem)
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask() ||
               up_interrupt_context());
 
+#ifdef CONFIG_SEM_FAST_PATH
+  /* A semaphore without priority inheritance or protection is taken with
+   * a single compare-and-swap.  Checking the count again inside the
+   * critical section would race with the lock-free path on other CPUs.
+   */
+
+  if (nxsem_fast_capable(sem))
+    {
+      return nxsem_fast_trywait(sem) ? OK : -EAGAIN;
+    }
+#endif
+
   /* The following operations must be performed with interrupts disabled
    * because sem_post() may be called from an interrupt handler.
    */
@@ -80,6 +80,15 @@ int nxsem_wait(FAR sem_t *sem)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
   DEBUGASSERT(!OSINIT_IDLELOOP() || !sched_idletask());
 
+#ifdef CONFIG_SEM_FAST_PATH
+  /* Take an uncontended semaphore without entering the critical section */
+
+  if (nxsem_fast_capable(sem) && nxsem_fast_trywait(sem))
+    {
+      return OK;
+    }
+#endif
+
   /* The following operations must be performed with interrupts
    * disabled because nxsem_post() may be called from an interrupt
    * handler.
@@ -89,20 +98,24 @@ int nxsem_wait(FAR sem_t *sem)
 
   /* Make sure we were supplied with a valid semaphore. */
 
-  /* Check if the lock is available */
-
   if (sem->semcount > 0)
     {
-      /* It is, let the task take the semaphore. */
-
       ret = nxsem_protect_wait(sem);
       if (ret < 0)
         {
           leave_critical_section(flags);
           return ret;
         }
+    }
+
+  /* Check if the lock is available.  The count is decremented in either
+   * case: a non-positive result records this task as a waiter.
+   */
+
+  if (nxsem_count_dec(sem) > 0)
+    {
+      /* It is, let the task take the semaphore. */
 
-      sem->semcount--;
       nxsem_add_holder(sem);
       rtcb->waitobj = NULL;
       ret = OK;
@@ -124,10 +137,6 @@ int nxsem_wait(FAR sem_t *sem)
 
       DEBUGASSERT(rtcb->waitobj == NULL);
 
-      /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-      sem->semcount--;
-
       /* Save the waited on semaphore in the TCB */
 
       rtcb->waitobj = sem;
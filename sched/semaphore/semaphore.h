@@ -35,6 +35,27 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Adjust the semaphore count and return the previous value.  With the
+ * lock-free fast path the count may also be changed outside of the
+ * critical section, so the slow path must update it atomically too.
+ */
+
+#ifdef CONFIG_SEM_FAST_PATH
+#  define nxsem_count_dec(s) \
+     atomic_fetch_sub_explicit((FAR atomic_short *)&(s)->semcount, 1, \
+                               memory_order_acq_rel)
+#  define nxsem_count_inc(s) \
+     atomic_fetch_add_explicit((FAR atomic_short *)&(s)->semcount, 1, \
+                               memory_order_acq_rel)
+#else
+#  define nxsem_count_dec(s) ((s)->semcount--)
+#  define nxsem_count_inc(s) ((s)->semcount++)
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -107,11 +107,17 @@ int wd_cancel_irq(FAR struct wdog_s *wdog)
    * cancellation is complete
    */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  /* Remove the watchdog from its wheel slot */
+
+  head = wd_wheel_delete(wdog);
+#else
   head = list_is_head(&g_wdactivelist, &wdog->node);
 
   /* Now, remove the watchdog from the timer queue */
 
   list_delete(&wdog->node);
+#endif
 
   /* Mark the watchdog inactive */
 
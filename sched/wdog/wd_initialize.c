@@ -40,9 +40,11 @@
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_TIMER_WHEEL
 #undef g_wdactivelist
 __percpu_data struct list_node g_wdactivelist = LIST_INITIAL_VALUE(g_wdactivelist);
 #define g_wdactivelist this_cpu_var(g_wdactivelist)
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -71,5 +73,9 @@ void wd_initialize(void)
 {
   /* Initialize watchdog lists */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  wd_wheel_initialize();
+#else
   list_initialize(&g_wdactivelist);
+#endif
 }
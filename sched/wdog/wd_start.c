@@ -129,6 +129,10 @@ static inline_function void wd_expiration(clock_t ticks)
    * other watchdogs that became ready to run at this time
    */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  while ((wdog = wd_wheel_expire(ticks)) != NULL)
+    {
+#else
   while (!list_is_empty(&g_wdactivelist))
     {
       wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
@@ -143,6 +147,7 @@ static inline_function void wd_expiration(clock_t ticks)
       /* Remove the watchdog from the head of the list */
 
       list_delete(&wdog->node);
+#endif
 
       /* Indicate that the watchdog is no longer active. */
 
@@ -181,14 +186,24 @@ static inline_function void wd_expiration(clock_t ticks)
  *   wdog and wdentry is not NULL.
  *
  * Returned Value:
- *   None.
+ *   True if the watchdog is now the first one to expire.
  *
  ****************************************************************************/
 
 static inline_function
-void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
+bool wd_insert(FAR struct wdog_s *wdog, clock_t expired,
                wdentry_t wdentry, wdparm_t arg)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  wdog->func = wdentry;
+  up_getpicbase(&wdog->picbase);
+  wdog->arg = arg;
+  wdog->expired = expired;
+
+  /* Hash the watchdog into its wheel slot, no list traversal needed */
+
+  return wd_wheel_insert(wdog);
+#else
   FAR struct wdog_s *curr;
 
   /* Traverse the watchdog list */
@@ -216,6 +231,9 @@ void wd_insert(FAR struct wdog_s *wdog, clock_t expired,
   up_getpicbase(&wdog->picbase);
   wdog->arg = arg;
   wdog->expired = expired;
+
+  return list_is_head(&g_wdactivelist, &wdog->node);
+#endif
 }
 
 /****************************************************************************
@@ -299,15 +317,18 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      reassess |= wd_wheel_delete(wdog);
+#else
       reassess |= list_is_head(&g_wdactivelist, &wdog->node);
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
-  wd_insert(wdog, ticks, wdentry, arg);
+  reassess |= wd_insert(wdog, ticks, wdentry, arg);
 
-  if (!g_wdtimernested &&
-      (reassess || list_is_head(&g_wdactivelist, &wdog->node)))
+  if (!g_wdtimernested && reassess)
     {
       /* Resume the interval timer that will generate the next
        * interval event. If the timer at the head of the list changed,
@@ -323,7 +344,11 @@ int wd_start_abstick(FAR struct wdog_s *wdog, clock_t ticks,
 
   if (WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+      wd_wheel_delete(wdog);
+#else
       list_delete(&wdog->node);
+#endif
       wdog->func = NULL;
     }
 
@@ -414,7 +439,11 @@ int wd_start(FAR struct wdog_s *wdog, sclock_t delay,
 #ifdef CONFIG_SCHED_TICKLESS
 clock_t wd_timer(clock_t ticks, bool noswitches)
 {
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  clock_t expired;
+#else
   FAR struct wdog_s *wdog;
+#endif
   irqstate_t flags;
   sclock_t ret;
 
@@ -429,6 +458,15 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   /* Return the delay for the next watchdog to expire */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+  if (!wd_wheel_first(&expired))
+    {
+      leave_critical_section(flags);
+      return 0;
+    }
+
+  ret = expired - ticks;
+#else
   if (list_is_empty(&g_wdactivelist))
     {
       leave_critical_section(flags);
@@ -441,6 +479,7 @@ clock_t wd_timer(clock_t ticks, bool noswitches)
 
   wdog = list_first_entry(&g_wdactivelist, struct wdog_s, node);
   ret = wdog->expired - ticks;
+#endif
 
   leave_critical_section(flags);
 
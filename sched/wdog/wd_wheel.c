@@ -0,0 +1,473 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Span of one slot and of a full revolution at the given level */
+
+#define WDOG_WHEEL_SPAN(l)   ((clock_t)1 << ((l) * WDOG_WHEEL_BITS))
+#define WDOG_WHEEL_RANGE(l)  WDOG_WHEEL_SPAN((l) + 1)
+
+/* Largest delay that fits in the wheel without being clamped */
+
+#define WDOG_WHEEL_MAXDELAY  (WDOG_WHEEL_RANGE(WDOG_WHEEL_LEVELS - 1) - 1)
+
+#define WDOG_WHEEL_INDEX(t, l) \
+  ((unsigned int)((t) >> ((l) * WDOG_WHEEL_BITS)) & WDOG_WHEEL_MASK)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#undef g_wdwheel
+__percpu_bss struct wd_wheel_s g_wdwheel;
+#define g_wdwheel this_cpu_var(g_wdwheel)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_place
+ *
+ * Description:
+ *   Hash the watchdog into the wheel slot that covers its expiration time
+ *   relative to the current wheel position.  Watchdogs that are already
+ *   due go to the slot of the current tick, watchdogs beyond the wheel
+ *   range are parked in the farthest top level slot and cascaded down
+ *   again when that slot is reached.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_place(FAR struct wd_wheel_s *wheel,
+                           FAR struct wdog_s *wdog)
+{
+  sclock_t delay = (sclock_t)(wdog->expired - wheel->now);
+  clock_t expired = wdog->expired;
+  unsigned int level = 0;
+  unsigned int index;
+
+  if (delay <= 0)
+    {
+      expired = wheel->now;
+    }
+  else if (delay > WDOG_WHEEL_MAXDELAY)
+    {
+      expired = wheel->now + WDOG_WHEEL_MAXDELAY;
+      level   = WDOG_WHEEL_LEVELS - 1;
+    }
+  else
+    {
+      while ((clock_t)delay >= WDOG_WHEEL_SPAN(level + 1))
+        {
+          level++;
+        }
+    }
+
+  index = WDOG_WHEEL_INDEX(expired, level);
+  list_add_tail(&wheel->slot[level][index], &wdog->node);
+  wheel->map[level] |= (uint32_t)1 << index;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_slot
+ *
+ * Description:
+ *   Find the first non-empty slot of a level, in wheel order, and return
+ *   the tick at which it falls due: its expiration for level zero, or the
+ *   time it must be cascaded for the upper levels.  Bits of slots that
+ *   emptied through wd_cancel() are cleared lazily here.
+ *
+ ****************************************************************************/
+
+static bool wd_wheel_slot(FAR struct wd_wheel_s *wheel, unsigned int level,
+                          FAR unsigned int *slot, FAR clock_t *due)
+{
+  unsigned int current = WDOG_WHEEL_INDEX(wheel->now, level);
+  unsigned int start = level == 0 ? current : current + 1;
+  uint32_t pending;
+  unsigned int index;
+  clock_t base;
+
+  for (; ; )
+    {
+      if (wheel->map[level] == 0)
+        {
+          return false;
+        }
+
+      pending = start < WDOG_WHEEL_SLOTS ?
+                wheel->map[level] & ~(((uint32_t)1 << start) - 1) : 0;
+      if (pending == 0)
+        {
+          pending = wheel->map[level];
+        }
+
+      index = ffs(pending) - 1;
+      if (!list_is_empty(&wheel->slot[level][index]))
+        {
+          break;
+        }
+
+      wheel->map[level] &= ~((uint32_t)1 << index);
+    }
+
+  base = wheel->now & ~(WDOG_WHEEL_RANGE(level) - 1);
+  if (index < start)
+    {
+      base += WDOG_WHEEL_RANGE(level);
+    }
+
+  *slot = index;
+  *due  = base + index * WDOG_WHEEL_SPAN(level);
+  return true;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_event
+ *
+ * Description:
+ *   Return the tick of the next wheel event, i.e. the nearest slot that
+ *   either expires or needs to be cascaded.
+ *
+ ****************************************************************************/
+
+static bool wd_wheel_event(FAR struct wd_wheel_s *wheel, FAR clock_t *tick)
+{
+  unsigned int level;
+  unsigned int slot;
+  bool found = false;
+  clock_t due;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (wd_wheel_slot(wheel, level, &slot, &due) &&
+          (!found || (sclock_t)(due - *tick) < 0))
+        {
+          *tick = due;
+          found = true;
+        }
+    }
+
+  return found;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Move the watchdogs of every upper level slot that falls due at the
+ *   current wheel position down to the finer levels.  Levels are walked
+ *   from the top so that a watchdog can fall through several levels in
+ *   one step.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(FAR struct wd_wheel_s *wheel)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct list_node *slot;
+  struct list_node pending;
+  unsigned int level;
+  unsigned int index;
+
+  for (level = WDOG_WHEEL_LEVELS - 1; level > 0; level--)
+    {
+      if ((wheel->now & (WDOG_WHEEL_SPAN(level) - 1)) != 0)
+        {
+          continue;
+        }
+
+      index = WDOG_WHEEL_INDEX(wheel->now, level);
+      slot  = &wheel->slot[level][index];
+      wheel->map[level] &= ~((uint32_t)1 << index);
+
+      if (list_is_empty(slot))
+        {
+          continue;
+        }
+
+      /* Detach the slot first, the watchdogs are rehashed relative to the
+       * new wheel position and may land in the same slot again.
+       */
+
+      pending.next       = slot->next;
+      pending.prev       = slot->prev;
+      pending.next->prev = &pending;
+      pending.prev->next = &pending;
+      list_initialize(slot);
+
+      while (!list_is_empty(&pending))
+        {
+          wdog = list_first_entry(&pending, struct wdog_s, node);
+          list_delete(&wdog->node);
+          wd_wheel_place(wheel, wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timing wheel of the calling CPU.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  FAR struct wd_wheel_s *wheel = &g_wdwheel;
+  unsigned int level;
+  unsigned int index;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      wheel->map[level] = 0;
+      for (index = 0; index < WDOG_WHEEL_SLOTS; index++)
+        {
+          list_initialize(&wheel->slot[level][index]);
+        }
+    }
+
+  wheel->now       = clock_systime_ticks();
+  wheel->nextvalid = false;
+  wheel->count     = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Hash an armed watchdog into the timing wheel in constant time.
+ *
+ * Returned Value:
+ *   True if the watchdog became the earliest one to expire, so the
+ *   interval timer has to be reassessed.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  FAR struct wd_wheel_s *wheel = &g_wdwheel;
+
+  /* An empty wheel may have been idle for a long time in tickless mode,
+   * move it up to the present so that the delay cannot wrap around.
+   */
+
+  if (wheel->count++ == 0)
+    {
+      wheel->now = clock_systime_ticks();
+    }
+
+  wd_wheel_place(wheel, wdog);
+
+  /* Without a valid cached expiration the new watchdog may or may not be
+   * the earliest one, let wd_wheel_first() find out.
+   */
+
+  if (!wheel->nextvalid)
+    {
+      return true;
+    }
+
+  if ((sclock_t)(wdog->expired - wheel->next) < 0)
+    {
+      wheel->next = wdog->expired;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_delete
+ *
+ * Description:
+ *   Remove an armed watchdog from the timing wheel in constant time.
+ *
+ * Returned Value:
+ *   True if the watchdog could have been the earliest one to expire, so
+ *   the interval timer has to be reassessed.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_delete(FAR struct wdog_s *wdog)
+{
+  FAR struct wd_wheel_s *wheel = &g_wdwheel;
+
+  list_delete(&wdog->node);
+
+  if (--wheel->count == 0 ||
+      (wheel->nextvalid && wdog->expired == wheel->next))
+    {
+      wheel->nextvalid = false;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expire
+ *
+ * Description:
+ *   Advance the wheel up to 'ticks' and remove the next watchdog that has
+ *   expired.  Empty stretches of the wheel are skipped using the slot
+ *   bitmaps, so the cost does not depend on the elapsed time.
+ *
+ * Returned Value:
+ *   The expired watchdog, or NULL if none is due at 'ticks'.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expire(clock_t ticks)
+{
+  FAR struct wd_wheel_s *wheel = &g_wdwheel;
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  clock_t tick = 0;
+
+  for (; ; )
+    {
+      slot = &wheel->slot[0][WDOG_WHEEL_INDEX(wheel->now, 0)];
+      if (!list_is_empty(slot) && clock_compare(wheel->now, ticks))
+        {
+          wdog = list_first_entry(slot, struct wdog_s, node);
+          wd_wheel_delete(wdog);
+          return wdog;
+        }
+
+      if (!wd_wheel_event(wheel, &tick) || !clock_compare(tick, ticks))
+        {
+          if ((sclock_t)(ticks - wheel->now) > 0)
+            {
+              wheel->now = ticks;
+            }
+
+          if (wheel->nextvalid && clock_compare(wheel->next, wheel->now))
+            {
+              wheel->nextvalid = false;
+            }
+
+          return NULL;
+        }
+
+      wheel->now = tick;
+      wd_wheel_cascade(wheel);
+
+      /* A cached cascade time is stale once the wheel has reached it */
+
+      if (wheel->nextvalid && clock_compare(wheel->next, wheel->now))
+        {
+          wheel->nextvalid = false;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_first
+ *
+ * Description:
+ *   Get the expiration time of the earliest armed watchdog.  Only the
+ *   first non-empty slot of each level has to be examined since the slots
+ *   of a level cover consecutive time ranges.  The top level also holds
+ *   the clamped, far away watchdogs, so its cascade time is used as a
+ *   lower bound instead: at worst this costs one early wakeup.
+ *
+ * Returned Value:
+ *   False if no watchdog is armed.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_first(FAR clock_t *expired)
+{
+  FAR struct wd_wheel_s *wheel = &g_wdwheel;
+  FAR struct wdog_s *wdog;
+  unsigned int level;
+  unsigned int slot;
+  clock_t due;
+
+  if (wheel->nextvalid)
+    {
+      *expired = wheel->next;
+      return true;
+    }
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      if (!wd_wheel_slot(wheel, level, &slot, &due))
+        {
+          continue;
+        }
+
+      if (level == WDOG_WHEEL_LEVELS - 1)
+        {
+          if (!wheel->nextvalid || (sclock_t)(due - wheel->next) < 0)
+            {
+              wheel->next      = due;
+              wheel->nextvalid = true;
+            }
+
+          continue;
+        }
+
+      list_for_every_entry(&wheel->slot[level][slot], wdog,
+                           struct wdog_s, node)
+        {
+          if (!wheel->nextvalid ||
+              (sclock_t)(wdog->expired - wheel->next) < 0)
+            {
+              wheel->next      = wdog->expired;
+              wheel->nextvalid = true;
+            }
+        }
+    }
+
+  *expired = wheel->next;
+  return wheel->nextvalid;
+}
+
+#endif /* CONFIG_WDOG_TIMER_WHEEL */
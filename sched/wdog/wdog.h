@@ -46,6 +46,34 @@
 
 #define list_node wdlist_node
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+/* Geometry of the hierarchical timing wheel: WDOG_WHEEL_LEVELS levels of
+ * WDOG_WHEEL_SLOTS slots each, every level being WDOG_WHEEL_SLOTS times
+ * coarser than the one below it.
+ */
+
+#  define WDOG_WHEEL_BITS      5
+#  define WDOG_WHEEL_SLOTS     (1 << WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK      (WDOG_WHEEL_SLOTS - 1)
+#  define WDOG_WHEEL_LEVELS    5
+#endif
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+struct wd_wheel_s
+{
+  clock_t          now;        /* Wheel position, all earlier ticks are done */
+  clock_t          next;       /* Cached earliest expiration time */
+  bool             nextvalid;  /* True: next holds the earliest expiration */
+  unsigned int     count;      /* Number of armed watchdogs */
+  uint32_t         map[WDOG_WHEEL_LEVELS];  /* Bitmap of non-empty slots */
+  struct list_node slot[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -63,8 +91,18 @@ extern "C"
  * this linked list are removed and the function is called.
  */
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+/* With CONFIG_WDOG_TIMER_WHEEL the active watchdogs are hashed into a
+ * hierarchical timing wheel instead, so that arming and cancelling them
+ * does not depend on the number of active watchdogs.
+ */
+
+extern struct wd_wheel_s g_wdwheel;
+#define g_wdwheel this_cpu_var(g_wdwheel)
+#else
 extern struct list_node g_wdactivelist;
 #define g_wdactivelist this_cpu_var(g_wdactivelist)
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -145,6 +183,85 @@ void wd_timer(clock_t ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_WDOG_TIMER_WHEEL
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timing wheel of the calling CPU.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void);
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Hash an armed watchdog (wdog->expired already set) into the timing
+ *   wheel in constant time.
+ *
+ * Returned Value:
+ *   True if the watchdog became the earliest one to expire.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_insert(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_delete
+ *
+ * Description:
+ *   Remove an armed watchdog from the timing wheel in constant time.
+ *
+ * Returned Value:
+ *   True if the watchdog may have been the earliest one to expire.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_delete(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_expire
+ *
+ * Description:
+ *   Advance the timing wheel to 'ticks' and remove the next watchdog that
+ *   has expired at that time.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if there is none.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expire(clock_t ticks);
+
+/****************************************************************************
+ * Name: wd_wheel_first
+ *
+ * Description:
+ *   Get the expiration time of the earliest armed watchdog.
+ *
+ * Returned Value:
+ *   False if no watchdog is armed.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_first(FAR clock_t *expired);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }